@@ -0,0 +1,36 @@
+// analysis.h
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include "task.h"
+#include <vector>
+
+namespace RTOS {
+
+// Параметры задачи для анализа; время в тех же единицах, что и период
+struct TaskParameters {
+  int period; // Период, он же относительный срок
+  int wcetLow;
+  int wcetHigh;
+  Criticality criticality;
+};
+
+struct ResponseTime {
+  int lowMode;  // Время отклика в режиме LO, -1 - превышает срок
+  int highMode; // Время отклика AMC-rtb для задач HI, -1 - превышает срок
+                // или задача LO
+  bool schedulable;
+};
+
+// Анализ времени отклика AMC-rtb (Baruah, Burns, Davis, 2011) для
+// невытесняющего планирования с фиксированными приоритетами. Задачи
+// передаются в порядке убывания приоритета. Блокировка задачи - наибольшее
+// время выполнения задачи с меньшим приоритетом; в режиме HI для задач LO
+// берётся бюджет LO, поскольку переключение режима отбрасывает их.
+// Возвращает true, если все задачи укладываются в сроки.
+bool analyzeAmcRtb(const std::vector<TaskParameters> &tasks,
+                   std::vector<ResponseTime> &result);
+
+} // namespace RTOS
+
+#endif // ANALYSIS_H
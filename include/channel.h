@@ -0,0 +1,100 @@
+// channel.h
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#include "interrupt.h"
+#include "system_log.h"
+#include "task.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace RTOS {
+
+// Заголовок канала в разделяемой памяти. Позиции записи и чтения лежат в
+// разных строках кэша, чтобы отправитель и получатель не мешали друг другу.
+struct ChannelHeader {
+  std::atomic<std::uint32_t> magic; // Выставляется последним при создании
+  std::uint32_t slotSize;
+  std::uint32_t slotCount;
+  std::uint32_t slotStride;
+
+  alignas(64) std::atomic<std::uint32_t> head; // Пишет только отправитель
+  std::atomic<int> dataWord; // Слово futex, растёт при каждой отправке
+  std::atomic<int> dataWaiters;
+
+  alignas(64) std::atomic<std::uint32_t> tail; // Пишет только получатель
+  std::atomic<int> spaceWord; // Слово futex, растёт при каждом приёме
+  std::atomic<int> spaceWaiters;
+};
+
+// Именованный канал между процессами: ограниченное кольцо сообщений в
+// разделяемой памяти (shm_open + mmap) с одним отправителем и одним
+// получателем. Сообщения пишутся и читаются прямо в слотах кольца без
+// копирования; ожидание данных и места - futex на разделяемых словах.
+//
+// Получение можно привязать к локальной задаче: поток-наблюдатель ждёт
+// новых сообщений и выставляет прерывание, отложенный обработчик которого
+// делает задачу готовой на точке диспетчеризации.
+class Channel {
+private:
+  int id;
+  std::string name;
+  bool owner; // Создатель удаляет имя при уничтожении канала
+  int fd;
+  void *memory;
+  std::size_t size;
+  ChannelHeader *header;
+  unsigned char *slots;
+  std::uint32_t cachedHead; // Копия позиции отправителя у получателя
+  std::uint32_t cachedTail; // Копия позиции получателя у отправителя
+  InterruptController &interrupts;
+  int irq;
+  std::atomic<bool> watching;
+  std::thread watcher;
+
+  bool map(int flags, std::size_t length);
+  unsigned char *slot(std::uint32_t position) const;
+  void watch();
+
+public:
+  Channel(int id, InterruptController &interrupts);
+  ~Channel();
+
+  Channel(const Channel &) = delete;
+  Channel &operator=(const Channel &) = delete;
+
+  // Создание нового канала либо подключение к созданному другим процессом
+  bool create(const std::string &channelName, int slotSize, int slotCount);
+  bool open(const std::string &channelName);
+
+  int getId() const;
+  const std::string &getName() const;
+  int getSlotSize() const;
+  int getCapacity() const;
+  int getPending() const;
+
+  // Отправитель: beginSend возвращает слот для записи или nullptr, если
+  // кольцо заполнено; endSend публикует length байт слота и возвращает
+  // false, не публикуя сообщение, если length больше размера слота
+  void *beginSend();
+  bool endSend(std::size_t length);
+  bool send(const void *data, std::size_t length);
+  bool waitForSpace(std::chrono::nanoseconds timeout);
+
+  // Получатель: beginReceive возвращает очередное сообщение или nullptr;
+  // сообщение действительно до вызова endReceive
+  const void *beginReceive(std::size_t &length);
+  void endReceive();
+  bool waitForData(std::chrono::nanoseconds timeout);
+
+  // Делает задачу готовой при поступлении сообщений
+  bool bindReceiver(Task *task);
+};
+
+} // namespace RTOS
+
+#endif // CHANNEL_H
@@ -0,0 +1,18 @@
+// config.h
+#ifndef CONFIG_H
+#define CONFIG_H
+
+namespace RTOS {
+
+// Константы системы
+constexpr int MAX_TASKS = 32;
+constexpr int MAX_PRIORITIES = 16;
+constexpr int MAX_RESOURCES = 16;
+constexpr int MAX_EVENTS = 16;
+constexpr int MAX_INTERRUPTS = 32;
+constexpr int MAX_CHANNELS = 16;
+constexpr int MAX_PARALLEL_WORKERS = 16;
+
+} // namespace RTOS
+
+#endif // CONFIG_H
@@ -0,0 +1,51 @@
+// cyclic_schedule.h
+#ifndef CYCLIC_SCHEDULE_H
+#define CYCLIC_SCHEDULE_H
+
+#include <string>
+#include <vector>
+
+namespace RTOS {
+
+// Параметры задачи для построения таблицы; время в миллисекундах
+struct CyclicTaskParameters {
+  int id;
+  int period; // Период, он же относительный срок
+  int wcet;
+  std::vector<int> predecessors; // id задач с тем же периодом
+};
+
+// Статическая таблица циклического исполнителя: гиперпериод делится на
+// кадры равной длины, для каждого кадра - id задач в порядке запуска
+struct CyclicSchedule {
+  int hyperperiod = 0;
+  int frameSize = 0;
+  std::vector<std::vector<int>> frames;
+};
+
+// Построение таблицы для гиперпериода. Длина кадра выбирается по
+// классическим условиям (Baker, Shaw): кадр не короче наибольшего WCET,
+// делит гиперпериод, и между выпуском задания и его сроком помещается
+// целый кадр (2f - gcd(p, f) <= p). Из допустимых длин берётся наибольшая,
+// для которой задания, упорядоченные по сроку и предшествованию, жадно
+// раскладываются по кадрам. Задания выполняются целиком, поэтому общие
+// ресурсы дополнительных ограничений не требуют.
+bool buildCyclicSchedule(const std::vector<CyclicTaskParameters> &tasks,
+                         CyclicSchedule &schedule);
+
+// Проверка таблицы, загруженной извне: число и окна заданий каждой задачи,
+// загрузка кадров и порядок предшествования
+bool verifyCyclicSchedule(const std::vector<CyclicTaskParameters> &tasks,
+                          const CyclicSchedule &schedule);
+
+// Текстовый формат:
+//   hyperperiod <мс>
+//   frame_size <мс>
+//   <номер кадра>: <id задачи> ...
+// Строки, начинающиеся с '#', пропускаются
+std::string exportCyclicSchedule(const CyclicSchedule &schedule);
+bool importCyclicSchedule(const std::string &text, CyclicSchedule &schedule);
+
+} // namespace RTOS
+
+#endif // CYCLIC_SCHEDULE_H
@@ -0,0 +1,71 @@
+// deadlock_detector.h
+#ifndef DEADLOCK_DETECTOR_H
+#define DEADLOCK_DETECTOR_H
+
+#include "config.h"
+#include "system_log.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace RTOS {
+
+class Task;
+class Semaphore;
+
+static_assert(MAX_TASKS <= 32 && MAX_RESOURCES <= 32,
+              "deadlock detector packs holders and paths into 32-bit masks");
+
+// Ребро цикла ожидания: задача ждёт семафор
+struct WaitForEdge {
+  int taskId;
+  int semaphoreId;
+};
+
+// Граф ожидания задача -> ресурс -> держатели одного планировщика, который
+// поддерживается инкрементально из Semaphore. Рёбра хранятся в массивах,
+// индексируемых id: держатели семафора - маской задач, ожидание задачи -
+// id семафора. Захват и освобождение обновляют граф одной атомарной
+// операцией без блокировок и выделения памяти; мьютекс детектора
+// сериализует только постановку в ожидание, где цикл ищется от нового
+// ребра.
+class DeadlockDetector {
+private:
+  std::atomic<bool> enabled;
+  std::mutex waitMutex;
+  std::atomic<std::uint32_t> heldBy[MAX_RESOURCES];
+  std::atomic<int> waitsFor[MAX_TASKS]; // id семафора, -1 - не ждёт
+  WaitForEdge lastCycle[MAX_RESOURCES + 1];
+  int lastCycleLength;
+  int detectedCount;
+
+  bool isBlockedOn(int taskId, int resourceId, std::uint32_t path,
+                   int *via) const;
+  void reset();
+
+public:
+  DeadlockDetector();
+  DeadlockDetector(const DeadlockDetector &) = delete;
+  DeadlockDetector &operator=(const DeadlockDetector &) = delete;
+
+  void setEnabled(bool state);
+  bool isEnabled() const {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  // Вызываются семафорами под их собственной блокировкой
+  bool onWait(const Task *task, const Semaphore *resource);
+  void onWaitEnded(const Task *task);
+  void onAcquired(const Task *task, const Semaphore *resource);
+  void onReleased(const Task *task, const Semaphore *resource);
+
+  void forgetTask(const Task *task);
+
+  std::vector<WaitForEdge> getLastCycle();
+  int getDetectedCount();
+};
+
+} // namespace RTOS
+
+#endif // DEADLOCK_DETECTOR_H
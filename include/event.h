@@ -2,19 +2,42 @@
 #ifndef EVENT_H
 #define EVENT_H
 
+#include "config.h"
+#include "published_list.h"
 #include "system_log.h"
 #include "task.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace RTOS {
 
 class Event {
 private:
+  // Ожидающая задача; срок deadline - только для ожидания в ядре, которое
+  // снимает планировщик. Ожидание на futex снимается самим потоком.
+  struct Waiter {
+    Task *task;
+    bool sleeping;
+    std::chrono::steady_clock::time_point deadline;
+  };
+
   int id;
   Task *owner;
-  bool triggered;
-  std::vector<Task *> waitingTasks;
-  SystemLog &logger;
+  std::atomic<bool> triggered;
+  std::atomic<int> generation; // Слово futex, растёт при каждой активации
+  std::atomic<int> sleepers;
+  std::vector<Waiter> waitingTasks;
+  // Задачи, ожидание которых в ядре истекло и ещё не сообщено им
+  std::uint32_t expiredWaits;
+  // Задачи, ожидание с таймаутом которых в ядре завершила активация; итог
+  // сохраняется до повторного вызова, даже если событие уже сброшено
+  std::uint32_t signalledWaits;
+  // Ближайший срок ожидания в ядре, нс steady_clock; проверка без mtx
+  std::atomic<std::int64_t> nextDeadline;
+  std::mutex mtx;
 
 public:
   Event(int id, Task *owner);
@@ -26,8 +49,18 @@ public:
   void reset();
   bool isTriggered() const;
   void waitFor(Task *task);
+  // Из тела задачи не блокирует, как Semaphore::acquire с таймаутом: false
+  // при не готовой задаче - ожидание, при готовой - срок истёк. Активация,
+  // разбудившая задачу, сообщается повторным вызовом и после reset()
+  bool waitFor(Task *task, std::chrono::milliseconds timeout);
+  void cancelWait(Task *task);
+  std::chrono::steady_clock::time_point
+  expireWaits(std::chrono::steady_clock::time_point now);
 };
 
+// События одного планировщика
+using EventList = PublishedList<Event, MAX_EVENTS>;
+
 } // namespace RTOS
 
 #endif // EVENT_H
@@ -0,0 +1,22 @@
+// futex.h
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include <atomic>
+#include <chrono>
+
+namespace RTOS {
+
+// Блокирует поток, пока *word == expected, но не дольше timeout.
+// Возвращает false по истечении таймаута; в остальных случаях (пробуждение,
+// изменившееся значение, прерывание сигналом) вызывающий перепроверяет
+// условие сам. shared включает ожидание на слове в разделяемой памяти.
+bool futexWait(std::atomic<int> *word, int expected,
+               std::chrono::nanoseconds timeout, bool shared = false);
+
+// Пробуждает до count потоков, ожидающих на word
+void futexWake(std::atomic<int> *word, int count, bool shared = false);
+
+} // namespace RTOS
+
+#endif // FUTEX_H
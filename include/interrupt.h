@@ -0,0 +1,99 @@
+// interrupt.h
+#ifndef INTERRUPT_H
+#define INTERRUPT_H
+
+#include "config.h"
+#include "system_log.h"
+#include "task.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace RTOS {
+
+static_assert(MAX_INTERRUPTS <= 32, "pending interrupts are a 32-bit mask");
+
+struct InterruptStats {
+  std::uint64_t raised;   // Вызовы raise
+  std::uint64_t serviced; // Обработки; повторные до обработки сливаются
+  std::uint64_t measured; // Измеренные задержки
+  std::uint64_t totalLatencyNs;
+  std::uint64_t maxLatencyNs;
+};
+
+// Симуляция прерываний. raise() можно вызывать из любого потока,
+// обработчика сигнала или таймера: он только выставляет бит в битовой
+// карте ожидающих прерываний и будит планировщик. Отложенные обработчики
+// (bottom half) выполняются потоком планировщика на точке диспетчеризации,
+// поэтому могут безопасно делать задачи готовыми.
+//
+// Задержка измеряется от первого raise до запуска целевой задачи, а для
+// источников без целевой задачи - до завершения обработчика.
+//
+// Снятый с регистрации источник перестаёт принимать raise сразу, а его
+// обработчик сбрасывается и номер освобождается потоком планировщика на
+// следующей обработке прерываний: обработчик мог выполняться в этот момент.
+class InterruptController {
+private:
+  struct Source {
+    std::function<void()> handler;
+    std::atomic<Task *> target;
+  };
+
+  Source sources[MAX_INTERRUPTS];
+  std::mutex registerMutex;
+  std::uint32_t allocated; // Занятые номера, включая снятые; под mtx
+  std::atomic<std::uint32_t> registered;
+  std::atomic<std::uint32_t> released; // Снятые, ещё не освобождённые
+  std::atomic<std::uint32_t> pending;
+  // Удалённые задачи, чьи слоты задержки ещё не сброшены
+  std::atomic<std::uint32_t> detachedTasks;
+  std::atomic<std::int64_t> raisedAt[MAX_INTERRUPTS];
+  std::atomic<std::uint64_t> raisedCount[MAX_INTERRUPTS];
+  std::atomic<std::uint64_t> servicedCount[MAX_INTERRUPTS];
+  std::atomic<std::uint64_t> measuredCount[MAX_INTERRUPTS];
+  std::atomic<std::uint64_t> totalLatency[MAX_INTERRUPTS];
+  std::atomic<std::uint64_t> maxLatency[MAX_INTERRUPTS];
+  std::atomic<int> wakeWord; // Слово futex для ожидания планировщика
+  std::atomic<bool> sleeping;
+
+  // Задачи, готовые по прерыванию и ещё не запущенные; только поток
+  // планировщика
+  std::int64_t targetRaisedAt[MAX_TASKS];
+  int targetSource[MAX_TASKS];
+
+  static std::int64_t now();
+  void recordLatency(int irq, std::int64_t raisedTime, std::int64_t doneTime);
+  void reclaim();
+
+public:
+  InterruptController();
+
+  InterruptController(const InterruptController &) = delete;
+  InterruptController &operator=(const InterruptController &) = delete;
+
+  // Возвращает номер прерывания или -1
+  int registerSource(std::function<void()> handler, Task *target = nullptr);
+  bool unregisterSource(int irq);
+  // Отвязывает источники от удаляемой задачи: они остаются
+  // зарегистрированными, но больше никого не делают готовым
+  void detachTask(Task *task);
+
+  // Безопасен для вызова из обработчика сигнала
+  void raise(int irq);
+
+  bool hasPending() const;
+  InterruptStats getStats(int irq) const;
+  void report();
+
+  // Вызываются только потоком планировщика
+  void dispatchPending();
+  void onTaskDispatched(const Task *task);
+  void waitForInterrupt(std::chrono::nanoseconds timeout);
+};
+
+} // namespace RTOS
+
+#endif // INTERRUPT_H
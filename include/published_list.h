@@ -0,0 +1,40 @@
+// published_list.h
+#ifndef PUBLISHED_LIST_H
+#define PUBLISHED_LIST_H
+
+#include <array>
+#include <atomic>
+
+namespace RTOS {
+
+// Список объектов ядра фиксированной ёмкости. Добавления сериализует
+// вызывающий; слот заполняется до публикации счётчика, поэтому читатели
+// в любых потоках без блокировок видят только заполненные слоты.
+// Элементы не удаляются до уничтожения владельца списка.
+template <typename T, int Capacity> class PublishedList {
+private:
+  std::array<T *, Capacity> items{};
+  std::atomic<int> count{0};
+
+public:
+  bool push(T *item) {
+    int size = count.load(std::memory_order_relaxed);
+    if (size == Capacity) {
+      return false;
+    }
+    items[size] = item;
+    count.store(size + 1, std::memory_order_release);
+    return true;
+  }
+
+  int size() const { return count.load(std::memory_order_acquire); }
+  bool full() const { return size() == Capacity; }
+  T *operator[](int index) const { return items[index]; }
+
+  T *const *begin() const { return items.data(); }
+  T *const *end() const { return items.data() + size(); }
+};
+
+} // namespace RTOS
+
+#endif // PUBLISHED_LIST_H
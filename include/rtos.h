@@ -12,20 +12,16 @@
 #include <thread>
 #include <vector>
 
+#include "channel.h"
+#include "config.h"
+#include "cyclic_schedule.h"
+#include "deadlock_detector.h"
 #include "event.h"
+#include "interrupt.h"
 #include "scheduler.h"
 #include "semaphore.h"
 #include "system_log.h"
 #include "task.h"
-
-namespace RTOS {
-
-// Константы системы
-constexpr int MAX_TASKS = 32;
-constexpr int MAX_PRIORITIES = 16;
-constexpr int MAX_RESOURCES = 16;
-constexpr int MAX_EVENTS = 16;
-
-} // namespace RTOS
+#include "worker_pool.h"
 
 #endif // RTOS_H
@@ -2,26 +2,111 @@
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
 
+#include "analysis.h"
+#include "channel.h"
+#include "cyclic_schedule.h"
+#include "deadlock_detector.h"
 #include "event.h"
+#include "interrupt.h"
 #include "semaphore.h"
+#include "seqlock.h"
+#include "snapshot.h"
 #include "system_log.h"
 #include "task.h"
+#include "task_control.h"
+#include "worker_pool.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
 namespace RTOS {
 
+// Неизменяемая таблица задач в порядке RMA. Изменения публикуют новую
+// таблицу, которую планировщик подхватывает на точке диспетчеризации;
+// старые таблицы освобождаются вместе с последней ссылкой на них.
+struct TaskTable {
+  std::vector<Task *> tasks;
+  std::uint32_t members = 0; // Маска id задач таблицы
+  std::array<Task *, MAX_TASKS> byId{};
+};
+
+// Судьба задач LO в режиме HI: их готовые задания отбрасываются либо
+// выполняются в фоне, только когда нет готовых задач HI. В режим LO
+// система возвращается, когда не готова ни одна задача
+enum class SheddingPolicy { Drop, Degrade };
+
+// Накладные расходы точек диспетчеризации без времени выполнения задач
+struct DispatchStats {
+  std::uint64_t dispatches;
+  std::uint64_t totalOverheadNs;
+  std::uint64_t maxOverheadNs;
+};
+
+// Выбор задач во время работы по приоритетам либо по статической таблице
+// циклического исполнителя
+enum class SchedulingMode { Priority, Cyclic };
+
 class Scheduler {
 private:
-  std::vector<Task *> tasks;
-  std::vector<Semaphore *> semaphores;
-  std::vector<Event *> events;
-  SystemLog &logger;
-  bool running;
+  // Удалённая задача освобождается, когда планировщик прошёл точку
+  // диспетчеризации после публикации таблицы без неё
+  struct RetiredTask {
+    Task *task;
+    std::uint64_t epoch;
+  };
+
+  TaskControlBlocks controlBlocks;
+  std::shared_ptr<const TaskTable> taskTable;
+  std::mutex tableMutex; // Сериализует только изменения таблицы
+  std::atomic<std::uint64_t> tableEpoch;
+  // Эпоха, увиденная планировщиком на последней точке диспетчеризации;
+  // ~0, если поток планировщика не работает
+  std::atomic<std::uint64_t> quiescentEpoch;
+  std::vector<RetiredTask> retiredTasks;
+  std::uint32_t usedTaskIds;
+  std::mutex resourceMutex; // Сериализует создание семафоров и событий
+  SemaphoreList semaphores;
+  EventList events;
+  DeadlockDetector deadlocks;
+  std::vector<Channel *> channels;
+  InterruptController interrupts;
+  WorkerPool workers;
+  std::atomic<bool> running;
+  std::atomic<Criticality> criticalityMode;
+  std::atomic<SheddingPolicy> sheddingPolicy;
+  std::atomic<int> modeSwitches;
+  std::atomic<int> droppedJobs;
+  SchedulingMode schedulingMode;
+  CyclicSchedule cyclicSchedule;
+  std::atomic<int> frameOverruns;
   std::thread schedulerThread;
+  SeqLock<SchedulerSnapshot> snapshot;
+  std::uint64_t snapshotVersion;
+  std::atomic<std::uint64_t> dispatchCount;
+  std::atomic<std::uint64_t> dispatchOverheadNs;
+  std::atomic<std::uint64_t> maxDispatchOverheadNs;
+  // Ближайший срок ожиданий в ядре; только поток планировщика
+  std::chrono::steady_clock::time_point nextWaitDeadline;
 
   void schedulerLoop();
+  bool dispatch(const TaskTable &table);
+  void cyclicLoop();
+  void recordDispatchOverhead(std::chrono::steady_clock::duration overhead);
+  void expireTimedWaits();
+  std::vector<CyclicTaskParameters> cyclicParameters() const;
+  int selectTask(const TaskTable &table);
+  void checkBudget(Task *task, std::chrono::steady_clock::duration elapsed);
+  void switchMode(Criticality mode);
+  void publishSnapshot(const TaskTable &table, int runningTaskId);
+  void publishTable(std::shared_ptr<TaskTable> table);
+  void assignRmaPriorities(const TaskTable &table);
+  bool admit(const TaskTable &table, int period, int wcet);
+  void reclaimRetiredTasks();
 
 public:
   Scheduler();
@@ -33,17 +118,93 @@ public:
   }
 
   Task *createTask(int priority, int period,
-                   std::function<void()> taskFunction);
-  Semaphore *createSemaphore();
+                   std::function<void()> taskFunction, int wcet = 0);
+  // Удаление отклоняется, пока задача удерживает семафор, владеет
+  // событиями или от её имени выполняется вызов ядра (например, ждёт
+  // поток). Задачу можно удалить и во время её тела, в том числе из него
+  // самого: после удаления захваты и ожидания от её имени отклоняются.
+  // Освобождение памяти откладывается только до точки диспетчеризации
+  // планировщика, поэтому остальные потоки не должны использовать
+  // указатель на задачу после вызова.
+  bool destroyTask(Task *task);
+  Semaphore *createSemaphore(int initialCount = 1);
   Event *createEvent(Task *owner);
+  // Межпроцессные каналы: создание нового либо подключение к каналу,
+  // созданному в другом процессе
+  Channel *createChannel(const std::string &name, int slotSize,
+                         int slotCount);
+  Channel *openChannel(const std::string &name);
 
   void start();
   void stop();
+  // Одна точка диспетчеризации в вызывающем потоке при остановленном
+  // планировщике; для моделирования в виртуальном времени
+  bool step();
 
-  const std::vector<Task *> &getTasks() const;
-  const std::vector<Semaphore *> &getSemaphores() const;
-  const std::vector<Event *> &getEvents() const;
+  // Поток, выполняющий тела задач: поток планировщика либо поток внутри
+  // step(). Ожидания с таймаутом в нём не блокируют поток, а снимаются
+  // планировщиком на точках диспетчеризации
+  static bool isDispatchThread();
+
+  // Указатели действительны до удаления соответствующей задачи;
+  // согласовать удаление с их пользователями должен вызывающий
+  std::vector<Task *> getTasks() const;
+  const SemaphoreList &getSemaphores() const;
+  const EventList &getEvents() const;
+  const std::vector<Channel *> &getChannels() const;
   bool isRunning() const;
+  InterruptController &getInterrupts();
+  DeadlockDetector &getDeadlockDetector();
+  WorkerPool &getWorkers();
+
+  // Параллельные циклы внутри тела задачи task: куски [from, to) по grain
+  // элементов выполняются вспомогательными потоками ядра с приоритетом
+  // задачи, включая унаследованный по PIP. Возврат - после всех кусков.
+  void parallelFor(const Task *task, std::size_t begin, std::size_t end,
+                   std::size_t grain, const WorkerPool::RangeBody &body);
+
+  // map(from, to) сворачивает кусок, combine объединяет частичные
+  // результаты в порядке кусков, поэтому итог не зависит от раздачи
+  template <typename T, typename Map, typename Combine>
+  T parallelReduce(const Task *task, std::size_t begin, std::size_t end,
+                   std::size_t grain, T identity, Map map, Combine combine) {
+    if (begin >= end) {
+      return identity;
+    }
+    grain = std::max<std::size_t>(1, grain);
+    std::vector<T> partial((end - begin + grain - 1) / grain, identity);
+    workers.run(task, begin, end, grain,
+                [&](std::size_t from, std::size_t to) {
+                  partial[(from - begin) / grain] = map(from, to);
+                });
+
+    T result = identity;
+    for (auto &value : partial)
+      result = combine(result, value);
+    return result;
+  }
+
+  // Смешанная критичность
+  void setSheddingPolicy(SheddingPolicy policy);
+  Criticality getCriticalityMode() const;
+  int getModeSwitchCount() const;
+  // Задания LO, отброшенные в режиме HI при SheddingPolicy::Drop
+  int getDroppedJobCount() const;
+  bool analyzeSchedulability(std::vector<ResponseTime> &result) const;
+
+  // Циклический исполнитель: режим выбирается до start(). Таблица строится
+  // при запуске, если не была построена или загружена заранее
+  bool setSchedulingMode(SchedulingMode mode);
+  SchedulingMode getSchedulingMode() const;
+  bool buildCyclicSchedule();
+  bool loadCyclicSchedule(const std::string &text);
+  std::string exportCyclicSchedule() const;
+  const CyclicSchedule &getCyclicSchedule() const;
+  int getFrameOverrunCount() const;
+
+  // Неблокирующий срез состояния для мониторинга из других потоков
+  SchedulerSnapshot getSnapshot() const;
+  DispatchStats getDispatchStats() const;
 };
 
 } // namespace RTOS
@@ -2,32 +2,110 @@
 #ifndef SEMAPHORE_H
 #define SEMAPHORE_H
 
+#include "config.h"
+#include "published_list.h"
+#include "snapshot.h"
 #include "system_log.h"
 #include "task.h"
-#include <condition_variable>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <mutex>
 #include <vector>
 
 namespace RTOS {
 
+class DeadlockDetector;
+class Semaphore;
+
+// Семафоры одного планировщика
+using SemaphoreList = PublishedList<Semaphore, MAX_RESOURCES>;
+
 class Semaphore {
 private:
-  std::mutex mtx;
-  std::condition_variable cv;
-  int count;
-  int originalOwnerPriority;
-  Task *owner;
-  std::vector<Task *> waitingTasks;
-  SystemLog &logger;
+  // Задача, удерживающая часть единиц ресурса
+  struct Holder {
+    Task *task;
+    int units;
+  };
+
+  // Задача, ожидающая освобождения единиц ресурса. Ожидание с таймаутом
+  // вне потока планировщика блокирует вызывающий поток на futex и
+  // снимается из очереди самим ожидающим (sleeping). В потоке планировщика
+  // задача только перестаёт быть готовой, а срок deadline проверяет
+  // планировщик на точках диспетчеризации.
+  struct Waiter {
+    Task *task;
+    int units;
+    bool sleeping;
+    std::chrono::steady_clock::time_point deadline;
+  };
+
+  mutable std::mutex mtx;
+  int id;
+  std::atomic<int> count; // Слово futex для ожидания с таймаутом
+  std::atomic<int> sleepers;
+  int maxCount;
+  std::atomic<int> inversions;
+  // Семафоры того же планировщика для пересчёта наследованных приоритетов
+  const SemaphoreList *siblings;
+  // Детектор взаимоблокировок планировщика; nullptr - без обнаружения
+  DeadlockDetector *deadlocks;
+  std::vector<Holder> holders;
+  std::vector<Waiter> waitingTasks;
+  // Задачи, ожидание которых в ядре истекло и ещё не сообщено им
+  std::uint32_t expiredWaits;
+  // Сроки ожиданий в ядре, разбуженных освобождением, по id задачи:
+  // повторный захват продолжает исходное ожидание, а не начинает новое
+  std::array<std::chrono::steady_clock::time_point, MAX_TASKS> wokenDeadlines;
+  // Ближайший срок ожидания в ядре, нс steady_clock; проверка без mtx
+  std::atomic<std::int64_t> nextDeadline;
+
+  bool take(Task *task, int units);
+  bool enqueue(Task *task, int units, bool sleeping,
+               std::chrono::steady_clock::time_point deadline);
+  bool isFirstEligible(const Task *task, int units) const;
+  std::vector<Task *> holdersExcept(const Task *task) const;
+  void updateInheritedPriority(Task *task);
 
 public:
-  Semaphore(int initialCount = 1);
+  Semaphore(int id, int initialCount = 1,
+            const SemaphoreList *siblings = nullptr,
+            DeadlockDetector *deadlocks = nullptr);
+
+  int getId() const;
+  int getCount() const;
+  int getMaxCount() const;
+  int getInversionCount() const;
+
+  std::vector<Task *> getWaitingTasks() const;
+  int getHighestWaiterPriority() const;
 
-  const std::vector<Task *> &getWaitingTasks() const { return waitingTasks; }
+  // false при не готовой задаче - задача ждёт освобождения. Ожидание,
+  // замыкающее цикл при включённом обнаружении взаимоблокировок,
+  // отклоняется: false, задача остаётся готовой и не ставится в очередь,
+  // а цикл доступен через DeadlockDetector::getLastCycle()
+  bool acquire(Task *task, int units = 1);
+  // Из тела задачи (поток планировщика) не блокирует: false при не
+  // готовой задаче означает ожидание до освобождения или срока, после
+  // которых задача снова запускается и повторяет захват; false при готовой
+  // задаче - срок предыдущего ожидания истёк. Повторный захват сохраняет
+  // срок первого вызова, поэтому ожидание ограничено им. В остальных
+  // потоках ждёт на futex и возвращает итог ожидания.
+  bool acquire(Task *task, std::chrono::milliseconds timeout, int units = 1);
+  bool tryAcquire(Task *task, int units = 1);
+  void release(Task *task, int units = 1);
+  void cancelWait(Task *task);
+  // Снимает ожидания в ядре со сроком не позже now; возвращает ближайший
+  // из оставшихся сроков. Вызывается планировщиком
+  std::chrono::steady_clock::time_point
+  expireWaits(std::chrono::steady_clock::time_point now);
 
-  bool acquire(Task *task);
-  void release(Task *task);
   Task *getOwner() const;
+  std::vector<Task *> getHolders() const;
+  int getHeldUnits(const Task *task) const;
+  SemaphoreState getState() const;
 };
 
 } // namespace RTOS
@@ -0,0 +1,76 @@
+// seqlock.h
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace RTOS {
+
+// Публикация значения одним писателем для любого числа читателей.
+// Писатель никогда не ждёт читателей, читатели никогда не блокируют
+// писателя: при пересечении с записью чтение просто повторяется.
+// Данные хранятся в атомарных словах, поэтому копирование не является
+// гонкой данных.
+template <typename T> class SeqLock {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SeqLock requires a trivially copyable type");
+
+private:
+  static constexpr std::size_t WORDS =
+      (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+  std::atomic<std::uint64_t> sequence;
+  std::atomic<std::uint64_t> words[WORDS];
+
+public:
+  SeqLock() : sequence(0) {
+    for (auto &word : words) {
+      word.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  SeqLock(const SeqLock &) = delete;
+  SeqLock &operator=(const SeqLock &) = delete;
+
+  // Вызывается только одним потоком-писателем
+  void write(const T &value) {
+    std::uint64_t buffer[WORDS] = {};
+    std::memcpy(buffer, &value, sizeof(T));
+
+    std::uint64_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t i = 0; i < WORDS; ++i) {
+      words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  T read() const {
+    std::uint64_t buffer[WORDS];
+    std::uint64_t before;
+    std::uint64_t after;
+
+    do {
+      before = sequence.load(std::memory_order_acquire);
+      for (std::size_t i = 0; i < WORDS; ++i) {
+        buffer[i] = words[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+
+    T value;
+    std::memcpy(&value, buffer, sizeof(T));
+    return value;
+  }
+};
+
+} // namespace RTOS
+
+#endif // SEQLOCK_H
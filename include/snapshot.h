@@ -0,0 +1,43 @@
+// snapshot.h
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "config.h"
+#include <cstdint>
+
+namespace RTOS {
+
+static_assert(MAX_TASKS <= 32, "task sets in snapshots are 32-bit masks");
+
+struct TaskState {
+  int id;
+  int period;
+  int basePriority;
+  int priority; // Эффективный приоритет с учётом PIP
+  bool ready;
+};
+
+// Множества держателей и ожидающих - битовые маски по id задач
+struct SemaphoreState {
+  int id;
+  int count;
+  int maxCount;
+  std::uint32_t holders;
+  std::uint32_t waiters;
+};
+
+// Согласованный срез состояния планировщика на точке диспетчеризации
+struct SchedulerSnapshot {
+  std::uint64_t version;
+  bool running;
+  bool highCriticalityMode;
+  int runningTaskId; // -1, если ни одна задача не выполняется
+  int taskCount;
+  TaskState tasks[MAX_TASKS];
+  int semaphoreCount;
+  SemaphoreState semaphores[MAX_RESOURCES];
+};
+
+} // namespace RTOS
+
+#endif // SNAPSHOT_H
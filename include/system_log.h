@@ -2,29 +2,88 @@
 #ifndef SYSTEM_LOG_H
 #define SYSTEM_LOG_H
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <ctime>
 #include <mutex>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+// Уровни журнала. Записи выше RTOS_LOG_LEVEL удаляются при компиляции
+// вместе с вычислением аргументов.
+#define RTOS_LOG_LEVEL_OFF 0
+#define RTOS_LOG_LEVEL_ERROR 1
+#define RTOS_LOG_LEVEL_WARNING 2
+#define RTOS_LOG_LEVEL_INFO 3
+#define RTOS_LOG_LEVEL_DEBUG 4
+
+#ifndef RTOS_LOG_LEVEL
+#define RTOS_LOG_LEVEL RTOS_LOG_LEVEL_DEBUG
+#endif
+
 namespace RTOS {
 
+enum class LogLevel { Error = 1, Warning, Info, Debug };
+
+// Категории записей; маска категорий задаётся во время работы
+enum LogCategory : std::uint32_t {
+  LOG_SCHEDULER = 1u << 0,
+  LOG_SEMAPHORE = 1u << 1,
+  LOG_EVENT = 1u << 2,
+  LOG_INTERRUPT = 1u << 3,
+  LOG_DEADLOCK = 1u << 4,
+  LOG_CHANNEL = 1u << 5,
+  LOG_ALL = ~0u
+};
+
 class SystemLog {
 private:
   std::vector<std::string> eventLog;
   std::mutex logMutex;
+  static std::atomic<std::uint32_t> categoryMask;
 
   SystemLog() = default;
   SystemLog(const SystemLog &) = delete;
   SystemLog &operator=(const SystemLog &) = delete;
 
+  static void appendField(std::string &out, const std::string &value) {
+    out += value;
+  }
+  static void appendField(std::string &out, const char *value) {
+    out += value;
+  }
+  template <typename T>
+  static typename std::enable_if<std::is_arithmetic<T>::value>::type
+  appendField(std::string &out, T value) {
+    out += std::to_string(value);
+  }
+
 public:
   static SystemLog &getInstance() {
     static SystemLog instance;
     return instance;
   }
 
+  // Проверка маски - единственная цена отключённой категории
+  static bool isEnabled(LogCategory category) {
+    return (categoryMask.load(std::memory_order_relaxed) & category) != 0;
+  }
+  static void setCategoryMask(std::uint32_t mask);
+  static std::uint32_t getCategoryMask();
+
+  // Форматирование выполняется только для сохраняемой записи
+  template <typename... Args>
+  void record(LogLevel level, const Args &...args) {
+    std::string message = level == LogLevel::Error     ? "ERROR: "
+                          : level == LogLevel::Warning ? "WARNING: "
+                                                       : "";
+    int fields[] = {0, (appendField(message, args), 0)...};
+    (void)fields;
+    logEvent(message);
+  }
+
   void logEvent(const std::string &eventDescription);
   const std::vector<std::string> &getLog() const;
   void clearLog();
@@ -32,4 +91,55 @@ public:
 
 } // namespace RTOS
 
+// RTOS_LOG(LEVEL, CATEGORY, части сообщения...), например
+// RTOS_LOG(DEBUG, SCHEDULER, "Task ", id, " selected for execution").
+// Аргументы вычисляются, только если категория включена.
+#define RTOS_LOG(level, category, ...)                                         \
+  RTOS_LOG_##level(::RTOS::LOG_##category, __VA_ARGS__)
+
+#define RTOS_LOG_RECORD(level, category, ...)                                  \
+  do {                                                                         \
+    if (::RTOS::SystemLog::isEnabled(category)) {                              \
+      ::RTOS::SystemLog::getInstance().record(level, __VA_ARGS__);             \
+    }                                                                          \
+  } while (0)
+
+// Отключённая запись не вычисляется и не попадает в код, но остаётся
+// проверяемой компилятором
+#define RTOS_LOG_DISCARD(...)                                                  \
+  do {                                                                         \
+    if (false) {                                                               \
+      ::RTOS::SystemLog::getInstance().record(::RTOS::LogLevel::Debug,         \
+                                              __VA_ARGS__);                    \
+    }                                                                          \
+  } while (0)
+
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_ERROR
+#define RTOS_LOG_ERROR(category, ...)                                          \
+  RTOS_LOG_RECORD(::RTOS::LogLevel::Error, category, __VA_ARGS__)
+#else
+#define RTOS_LOG_ERROR(category, ...) RTOS_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_WARNING
+#define RTOS_LOG_WARNING(category, ...)                                        \
+  RTOS_LOG_RECORD(::RTOS::LogLevel::Warning, category, __VA_ARGS__)
+#else
+#define RTOS_LOG_WARNING(category, ...) RTOS_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_INFO
+#define RTOS_LOG_INFO(category, ...)                                           \
+  RTOS_LOG_RECORD(::RTOS::LogLevel::Info, category, __VA_ARGS__)
+#else
+#define RTOS_LOG_INFO(category, ...) RTOS_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_DEBUG
+#define RTOS_LOG_DEBUG(category, ...)                                          \
+  RTOS_LOG_RECORD(::RTOS::LogLevel::Debug, category, __VA_ARGS__)
+#else
+#define RTOS_LOG_DEBUG(category, ...) RTOS_LOG_DISCARD(__VA_ARGS__)
+#endif
+
 #endif // SYSTEM_LOG_H
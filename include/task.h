@@ -2,6 +2,8 @@
 #ifndef TASK_H
 #define TASK_H
 
+#include "task_control.h"
+#include <atomic>
 #include <functional>
 #include <vector>
 
@@ -9,28 +11,81 @@ namespace RTOS {
 
 class Event;
 
+// Уровень критичности для смешанной критичности (AMC)
+enum class Criticality { Low = 0, High = 1 };
+
+// Дескриптор задачи. Горячие поля (приоритеты, готовность, период) хранятся
+// в TaskControlBlocks планировщика по id задачи, здесь - только холодные
+// данные.
 class Task {
 private:
+  TaskControlBlocks &controlBlocks;
   int id;
-  int priority;
-  int period; // Для RMA
-  bool ready;
+  // Бюджеты времени выполнения по уровням критичности, 0 - неизвестно
+  int wcet[2];
   std::function<void()> taskFunction;
   std::vector<Event *> ownedEvents;
+  // Задачи, задания которых должны завершиться раньше заданий этой задачи
+  std::vector<Task *> predecessors;
+  // Незавершённые вызовы ядра от имени задачи; -1 после удаления задачи
+  std::atomic<int> kernelCalls;
 
 public:
-  Task(int id, int priority, int period, std::function<void()> func);
+  Task(TaskControlBlocks &controlBlocks, int id, int priority, int period,
+       std::function<void()> func);
 
   int getId() const;
+  const TaskControlBlocks &getControlBlocks() const;
   int getPriority() const;
+  int getBasePriority() const;
   void setPriority(int newPriority);
+  void setBasePriority(int newPriority);
+  void setEffectivePriority(int newPriority);
   int getPeriod() const;
+  Criticality getCriticality() const;
+  void setCriticality(Criticality level);
+  int getWcet(Criticality level = Criticality::Low) const;
+  void setWcet(int newWcet);
+  void setWcet(Criticality level, int budget);
   bool isReady() const;
   void setReady(bool state);
 
   void execute();
   void addEvent(Event *event);
   std::vector<Event *> &getEvents();
+  void addPredecessor(Task *task);
+  void removePredecessor(Task *task);
+  const std::vector<Task *> &getPredecessors() const;
+
+  // Захват семафора или ожидание события держит задачу: пока вызов не
+  // завершён, задача не удаляется, а после удаления новые вызовы
+  // отклоняются. restore() отменяет retire(), если удаление не состоялось
+  bool beginKernelCall();
+  void endKernelCall();
+  bool retire();
+  void restore();
+};
+
+// Вызов ядра от имени задачи на время области видимости
+class TaskCall {
+private:
+  Task *task;
+  bool entered;
+
+public:
+  explicit TaskCall(Task *task)
+      : task(task), entered(task->beginKernelCall()) {}
+  ~TaskCall() {
+    if (entered) {
+      task->endKernelCall();
+    }
+  }
+
+  TaskCall(const TaskCall &) = delete;
+  TaskCall &operator=(const TaskCall &) = delete;
+
+  // false - задача удалена
+  bool isEntered() const { return entered; }
 };
 
 } // namespace RTOS
@@ -0,0 +1,58 @@
+// task_control.h
+#ifndef TASK_CONTROL_H
+#define TASK_CONTROL_H
+
+#include "config.h"
+#include <atomic>
+#include <cstdint>
+
+namespace RTOS {
+
+static_assert(MAX_TASKS % 8 == 0 && MAX_TASKS <= 32,
+              "task control blocks pack priorities by 8 and ready flags "
+              "into a 32-bit mask");
+static_assert(MAX_PRIORITIES < 255, "priorities are stored as bytes");
+
+// Горячие поля всех задач планировщика в виде массивов, индексируемых id
+// задачи. Приоритеты хранятся по байту на задачу в 64-битных словах и вместе
+// с масками готовности и критичности занимают первую строку кэша: выбор
+// задачи читает её несколькими атомарными загрузками, а затем сканирует
+// локальную копию векторизуемым циклом. Периоды нужны только для разрешения
+// равных приоритетов и лежат в следующих строках.
+struct alignas(64) TaskControlBlocks {
+  static constexpr int PRIORITY_WORDS = MAX_TASKS / 8;
+
+  std::atomic<std::uint64_t> priority[PRIORITY_WORDS]; // Эффективные
+  std::atomic<std::uint32_t> readyMask;
+  std::atomic<std::uint32_t> highCriticalityMask;
+  std::atomic<std::uint64_t> basePriority[PRIORITY_WORDS];
+  alignas(64) std::int32_t period[MAX_TASKS];
+
+  TaskControlBlocks();
+
+  // Инициализация слота при создании задачи
+  void reset(int id, int taskPriority, int taskPeriod);
+
+  int getPriority(int id) const;
+  void setPriority(int id, int value);
+  int getBasePriority(int id) const;
+  void setBasePriority(int id, int value);
+
+  bool isReady(int id) const;
+  void setReady(int id, bool state);
+
+  bool isHighCriticality(int id) const;
+  void setHighCriticality(int id, bool state);
+
+  // Наивысший эффективный приоритет среди задач маски; -1 для пустой маски
+  int highestPriority(std::uint32_t mask) const;
+
+  // id готовой задачи маски с наивысшим приоритетом; равные приоритеты
+  // разрешаются по меньшему периоду, затем по меньшему id. -1, если готовых
+  // задач нет.
+  int selectReady(std::uint32_t candidates) const;
+};
+
+} // namespace RTOS
+
+#endif // TASK_CONTROL_H
@@ -0,0 +1,84 @@
+// worker_pool.h
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "config.h"
+#include "task.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RTOS {
+
+// Приоритет ОС вспомогательного потока для куска задачи с приоритетом
+// taskPriority. Для SCHED_FIFO и SCHED_RR приоритет задачи отсчитывается
+// от минимального приоритета политики, но не ниже приоритета потока
+// вызывающей задачи threadPriority; у прочих политик одного уровня
+// приоритета threadPriority не меняется.
+int mapOsPriority(int policy, int threadPriority, int taskPriority);
+
+// Вспомогательные потоки ядра для параллельных циклов внутри тел задач.
+// Куски работы раздаются в порядке эффективного приоритета вызвавших задач
+// (с учётом PIP), который читается заново перед каждым куском. Перед
+// куском поток по возможности получает приоритет ОС из mapOsPriority, так
+// что наследование по PIP доходит до ОС только у политик реального
+// времени. Вызывающая задача выполняет куски сама и ждёт остальные,
+// поэтому для планировщика она выполняется, пока не завершится весь цикл.
+class WorkerPool {
+public:
+  using RangeBody = std::function<void(std::size_t, std::size_t)>;
+
+private:
+  struct Job {
+    const Task *owner;
+    const RangeBody *body;
+    std::size_t next; // Начало ещё не розданного куска; под mtx
+    std::size_t end;
+    std::size_t grain;
+    std::atomic<int> remaining; // Незавершённые куски
+    int policy;                 // Политика ОС потока вызывающей задачи
+    int osPriority;             // Приоритет ОС этого потока
+  };
+
+  std::mutex mtx;
+  std::condition_variable workAvailable;
+  std::vector<Job *> jobs; // Задания с нерозданными кусками
+  std::vector<std::thread> workers;
+  int workerCount;
+  bool started;
+  bool stopping;
+  std::atomic<int> completions; // Слово futex, растёт с каждым заданием
+  std::atomic<int> waiting;     // Вызывающие задачи, спящие на completions
+  std::atomic<int> workerPriority[MAX_PARALLEL_WORKERS];
+
+  bool take(Job *only, Job *&job, std::size_t &from, std::size_t &to);
+  void finish(Job *job);
+  void workerLoop(int index);
+  void startWorkers();
+
+public:
+  WorkerPool();
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  // Число потоков задаётся до первого параллельного цикла
+  bool setWorkerCount(int count);
+  int getWorkerCount() const;
+
+  // Приоритет задачи, кусок которой выполняет поток; -1 - поток простаивает
+  int getWorkerPriority(int worker) const;
+
+  // Выполняет body на [begin, end) кусками по grain элементов
+  void run(const Task *owner, std::size_t begin, std::size_t end,
+           std::size_t grain, const RangeBody &body);
+};
+
+} // namespace RTOS
+
+#endif // WORKER_POOL_H
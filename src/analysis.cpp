@@ -0,0 +1,118 @@
+// analysis.cpp
+#include "../include/analysis.h"
+#include <algorithm>
+
+namespace RTOS {
+
+namespace {
+
+int budget(const TaskParameters &task, Criticality level) {
+  if (level == Criticality::High && task.criticality == Criticality::High) {
+    return std::max(task.wcetLow, task.wcetHigh);
+  }
+  return task.wcetLow;
+}
+
+// Наибольшее время выполнения среди задач с меньшим приоритетом: при
+// невытесняющем планировании одна такая задача может занять процессор
+int blocking(const std::vector<TaskParameters> &tasks, size_t index,
+             Criticality level) {
+  int result = 0;
+  for (size_t j = index + 1; j < tasks.size(); ++j) {
+    result = std::max(result, budget(tasks[j], level));
+  }
+  return result;
+}
+
+int floorDiv(int a, int b) { return a / b; }
+
+int ceilDiv(int a, int b) { return (a + b - 1) / b; }
+
+// Время отклика в режиме LO: w - момент начала задания с учётом блокировки
+// и заданий задач с более высоким приоритетом, отклик - w + C(LO)
+int lowModeResponse(const std::vector<TaskParameters> &tasks, size_t index) {
+  const TaskParameters &task = tasks[index];
+  int base = blocking(tasks, index, Criticality::Low);
+
+  int w = base;
+  while (true) {
+    int next = base;
+    for (size_t j = 0; j < index; ++j) {
+      next += (floorDiv(w, tasks[j].period) + 1) * tasks[j].wcetLow;
+    }
+
+    if (next + task.wcetLow > task.period) {
+      return -1;
+    }
+    if (next == w) {
+      return w + task.wcetLow;
+    }
+    w = next;
+  }
+}
+
+// Время отклика AMC-rtb: задачи HI с более высоким приоритетом вносят
+// бюджеты HI, а задачи LO - не больше заданий, выпущенных за время отклика
+// в режиме LO
+int highModeResponse(const std::vector<TaskParameters> &tasks, size_t index,
+                     int lowResponse) {
+  const TaskParameters &task = tasks[index];
+  int cost = budget(task, Criticality::High);
+
+  int base = blocking(tasks, index, Criticality::High);
+  for (size_t j = 0; j < index; ++j) {
+    if (tasks[j].criticality == Criticality::Low) {
+      base += ceilDiv(lowResponse, tasks[j].period) * tasks[j].wcetLow;
+    }
+  }
+
+  int w = base;
+  while (true) {
+    int next = base;
+    for (size_t j = 0; j < index; ++j) {
+      if (tasks[j].criticality == Criticality::High) {
+        next += (floorDiv(w, tasks[j].period) + 1) *
+                budget(tasks[j], Criticality::High);
+      }
+    }
+
+    if (next + cost > task.period) {
+      return -1;
+    }
+    if (next == w) {
+      return w + cost;
+    }
+    w = next;
+  }
+}
+
+} // namespace
+
+bool analyzeAmcRtb(const std::vector<TaskParameters> &tasks,
+                   std::vector<ResponseTime> &result) {
+  result.assign(tasks.size(), ResponseTime{-1, -1, false});
+
+  for (auto &task : tasks) {
+    if (task.period <= 0) {
+      return false;
+    }
+  }
+
+  bool schedulable = true;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    ResponseTime &response = result[i];
+    response.lowMode = lowModeResponse(tasks, i);
+    response.schedulable = response.lowMode >= 0;
+
+    if (tasks[i].criticality == Criticality::High && response.schedulable) {
+      response.highMode = highModeResponse(tasks, i, response.lowMode);
+      response.schedulable = response.highMode >= 0;
+    }
+
+    schedulable = schedulable && response.schedulable;
+  }
+
+  return schedulable;
+}
+
+} // namespace RTOS
@@ -0,0 +1,334 @@
+// channel.cpp
+#include "../include/channel.h"
+#include "../include/futex.h"
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RTOS {
+
+namespace {
+
+constexpr std::uint32_t CHANNEL_MAGIC = 0x52544348; // "RTCH"
+
+// Проверок перед засыпанием на futex: короткий обмен обходится без
+// системных вызовов
+constexpr int SPIN_CHECKS = 200;
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+std::size_t slotsOffset() { return alignUp(sizeof(ChannelHeader), 64); }
+
+} // namespace
+
+Channel::Channel(int id, InterruptController &interrupts)
+    : id(id), owner(false), fd(-1), memory(nullptr), size(0),
+      header(nullptr), slots(nullptr), cachedHead(0), cachedTail(0),
+      interrupts(interrupts), irq(-1), watching(false) {}
+
+Channel::~Channel() {
+  if (watcher.joinable()) {
+    watching = false;
+    futexWake(&header->dataWord, INT_MAX, true);
+    watcher.join();
+  }
+  if (irq >= 0) {
+    interrupts.unregisterSource(irq);
+  }
+
+  if (memory) {
+    munmap(memory, size);
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+  if (owner) {
+    shm_unlink(name.c_str());
+  }
+}
+
+bool Channel::map(int flags, std::size_t length) {
+  void *address = mmap(nullptr, length, flags, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    RTOS_LOG(ERROR, CHANNEL, "Cannot map channel ", name, ": ",
+             std::strerror(errno));
+    return false;
+  }
+
+  memory = address;
+  size = length;
+  slots = static_cast<unsigned char *>(memory) + slotsOffset();
+  return true;
+}
+
+bool Channel::create(const std::string &channelName, int slotSize,
+                     int slotCount) {
+  if (slotSize <= 0 || slotCount <= 0 || (slotCount & (slotCount - 1))) {
+    RTOS_LOG(ERROR, CHANNEL, "Channel ", channelName,
+             " needs a positive slot size and a power-of-two slot count");
+    return false;
+  }
+
+  name = channelName;
+  fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    RTOS_LOG(ERROR, CHANNEL, "Cannot create channel ", name, ": ",
+             std::strerror(errno));
+    return false;
+  }
+  owner = true;
+
+  std::size_t stride = alignUp(sizeof(std::uint32_t) + slotSize, 64);
+  std::size_t length = slotsOffset() + stride * slotCount;
+  if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+    RTOS_LOG(ERROR, CHANNEL, "Cannot size channel ", name, ": ",
+             std::strerror(errno));
+    return false;
+  }
+  if (!map(PROT_READ | PROT_WRITE, length)) {
+    return false;
+  }
+
+  // Сигнатура публикуется последней: подключившийся процесс видит
+  // заголовок только целиком
+  header = new (memory) ChannelHeader();
+  header->slotSize = static_cast<std::uint32_t>(slotSize);
+  header->slotCount = static_cast<std::uint32_t>(slotCount);
+  header->slotStride = static_cast<std::uint32_t>(stride);
+  header->magic.store(CHANNEL_MAGIC, std::memory_order_release);
+
+  RTOS_LOG(INFO, CHANNEL, "Channel ", id, " created as ", name, " with ",
+           slotCount, " slots of ", slotSize, " bytes");
+  return true;
+}
+
+bool Channel::open(const std::string &channelName) {
+  name = channelName;
+  fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    RTOS_LOG(ERROR, CHANNEL, "Cannot open channel ", name, ": ",
+             std::strerror(errno));
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) < slotsOffset()) {
+    RTOS_LOG(ERROR, CHANNEL, "Channel ", name, " is not initialized");
+    return false;
+  }
+  if (!map(PROT_READ | PROT_WRITE, static_cast<std::size_t>(info.st_size))) {
+    return false;
+  }
+
+  header = static_cast<ChannelHeader *>(memory);
+  if (header->magic.load(std::memory_order_acquire) != CHANNEL_MAGIC ||
+      slotsOffset() + static_cast<std::size_t>(header->slotStride) *
+                          header->slotCount >
+          size) {
+    RTOS_LOG(ERROR, CHANNEL, "Channel ", name, " is not initialized");
+    return false;
+  }
+
+  cachedHead = header->head.load(std::memory_order_acquire);
+  cachedTail = header->tail.load(std::memory_order_acquire);
+
+  RTOS_LOG(INFO, CHANNEL, "Channel ", id, " opened as ", name);
+  return true;
+}
+
+int Channel::getId() const { return id; }
+
+const std::string &Channel::getName() const { return name; }
+
+int Channel::getSlotSize() const {
+  return static_cast<int>(header->slotSize);
+}
+
+int Channel::getCapacity() const {
+  return static_cast<int>(header->slotCount);
+}
+
+int Channel::getPending() const {
+  return static_cast<int>(header->head.load(std::memory_order_acquire) -
+                          header->tail.load(std::memory_order_acquire));
+}
+
+// Позиции растут без ограничений; число слотов - степень двойки, поэтому
+// переполнение счётчика не нарушает отображение на слоты
+unsigned char *Channel::slot(std::uint32_t position) const {
+  return slots + static_cast<std::size_t>(position & (header->slotCount - 1)) *
+                     header->slotStride;
+}
+
+void *Channel::beginSend() {
+  std::uint32_t head = header->head.load(std::memory_order_relaxed);
+  if (head - cachedTail == header->slotCount) {
+    cachedTail = header->tail.load(std::memory_order_acquire);
+    if (head - cachedTail == header->slotCount) {
+      return nullptr;
+    }
+  }
+  return slot(head) + sizeof(std::uint32_t);
+}
+
+bool Channel::endSend(std::size_t length) {
+  if (length > header->slotSize) {
+    RTOS_LOG(ERROR, CHANNEL, "Message of ", length,
+             " bytes does not fit channel ", name);
+    return false;
+  }
+
+  std::uint32_t head = header->head.load(std::memory_order_relaxed);
+  std::uint32_t stored = static_cast<std::uint32_t>(length);
+  std::memcpy(slot(head), &stored, sizeof(stored));
+  header->head.store(head + 1, std::memory_order_release);
+
+  header->dataWord.fetch_add(1);
+  if (header->dataWaiters.load() > 0) {
+    futexWake(&header->dataWord, INT_MAX, true);
+  }
+  return true;
+}
+
+bool Channel::send(const void *data, std::size_t length) {
+  if (length > header->slotSize) {
+    RTOS_LOG(ERROR, CHANNEL, "Message of ", length,
+             " bytes does not fit channel ", name);
+    return false;
+  }
+
+  void *target = beginSend();
+  if (!target) {
+    return false;
+  }
+  std::memcpy(target, data, length);
+  return endSend(length);
+}
+
+const void *Channel::beginReceive(std::size_t &length) {
+  std::uint32_t tail = header->tail.load(std::memory_order_relaxed);
+  if (tail == cachedHead) {
+    cachedHead = header->head.load(std::memory_order_acquire);
+    if (tail == cachedHead) {
+      return nullptr;
+    }
+  }
+
+  std::uint32_t stored;
+  std::memcpy(&stored, slot(tail), sizeof(stored));
+  length = stored;
+  return slot(tail) + sizeof(std::uint32_t);
+}
+
+void Channel::endReceive() {
+  std::uint32_t tail = header->tail.load(std::memory_order_relaxed);
+  if (tail == cachedHead) {
+    return;
+  }
+  header->tail.store(tail + 1, std::memory_order_release);
+
+  header->spaceWord.fetch_add(1);
+  if (header->spaceWaiters.load() > 0) {
+    futexWake(&header->spaceWord, INT_MAX, true);
+  }
+}
+
+// Ожидание изменения word, пока ready() ложно. Счётчик слова читается до
+// проверки условия, поэтому изменение между проверкой и засыпанием не
+// теряется: futex сразу вернётся.
+template <typename Ready>
+static bool waitShared(std::atomic<int> &word, std::atomic<int> &waiters,
+                       Ready ready, std::chrono::nanoseconds timeout) {
+  for (int i = 0; i < SPIN_CHECKS; ++i) {
+    if (ready()) {
+      return true;
+    }
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (true) {
+    int observed = word.load();
+    if (ready()) {
+      return true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      return false;
+    }
+
+    waiters++;
+    futexWait(&word, observed, deadline - now, true);
+    waiters--;
+  }
+}
+
+bool Channel::waitForData(std::chrono::nanoseconds timeout) {
+  return waitShared(
+      header->dataWord, header->dataWaiters,
+      [this]() {
+        return header->head.load(std::memory_order_acquire) !=
+               header->tail.load(std::memory_order_relaxed);
+      },
+      timeout);
+}
+
+bool Channel::waitForSpace(std::chrono::nanoseconds timeout) {
+  return waitShared(
+      header->spaceWord, header->spaceWaiters,
+      [this]() {
+        return header->head.load(std::memory_order_relaxed) -
+                   header->tail.load(std::memory_order_acquire) <
+               header->slotCount;
+      },
+      timeout);
+}
+
+bool Channel::bindReceiver(Task *task) {
+  if (irq >= 0) {
+    RTOS_LOG(ERROR, CHANNEL, "Channel ", name, " already has a receiver");
+    return false;
+  }
+
+  irq = interrupts.registerSource(std::function<void()>(), task);
+  if (irq < 0) {
+    return false;
+  }
+
+  watching = true;
+  watcher = std::thread([this]() { watch(); });
+  RTOS_LOG(INFO, CHANNEL, "Channel ", name, " bound to Task ", task->getId());
+  return true;
+}
+
+// Поток-наблюдатель: каждая новая отправка выставляет прерывание, которое
+// делает задачу-получателя готовой. Отправки до обработки прерывания
+// сливаются, поэтому задача забирает из кольца все сообщения сразу.
+void Channel::watch() {
+  int seen = header->dataWord.load();
+  if (getPending() > 0) {
+    interrupts.raise(irq);
+  }
+
+  while (watching) {
+    header->dataWaiters++;
+    futexWait(&header->dataWord, seen, std::chrono::milliseconds(100), true);
+    header->dataWaiters--;
+
+    int current = header->dataWord.load();
+    if (current != seen) {
+      seen = current;
+      interrupts.raise(irq);
+    }
+  }
+}
+
+} // namespace RTOS
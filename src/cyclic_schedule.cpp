@@ -0,0 +1,353 @@
+// cyclic_schedule.cpp
+#include "../include/cyclic_schedule.h"
+#include "../include/system_log.h"
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <sstream>
+
+namespace RTOS {
+
+namespace {
+
+// Ограничение размера таблицы: гиперпериод растёт как НОК периодов
+constexpr long long MAX_HYPERPERIOD = 1000000;
+constexpr long long MAX_JOBS = 100000;
+
+long long gcd(long long a, long long b) {
+  while (b) {
+    long long t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+struct Job {
+  size_t task;
+  int index; // Номер задания задачи в гиперпериоде
+  long long release;
+  long long deadline;
+};
+
+// Проверка параметров и порядок задач по предшествованию: rank[i] больше
+// рангов всех предшественников задачи i
+bool validate(const std::vector<CyclicTaskParameters> &tasks,
+              std::map<int, size_t> &indexById, std::vector<int> &rank,
+              long long &hyperperiod) {
+  if (tasks.empty()) {
+    RTOS_LOG(ERROR, SCHEDULER, "Cyclic schedule needs at least one task");
+    return false;
+  }
+
+  hyperperiod = 1;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    const CyclicTaskParameters &task = tasks[i];
+    if (task.period <= 0 || task.wcet <= 0 || task.wcet > task.period) {
+      RTOS_LOG(ERROR, SCHEDULER, "Task ", task.id,
+               " needs a positive WCET not exceeding its period for the "
+               "cyclic schedule");
+      return false;
+    }
+    indexById[task.id] = i;
+    hyperperiod = hyperperiod / gcd(hyperperiod, task.period) * task.period;
+    if (hyperperiod > MAX_HYPERPERIOD) {
+      RTOS_LOG(ERROR, SCHEDULER, "Hyperperiod exceeds ", MAX_HYPERPERIOD,
+               " ms");
+      return false;
+    }
+  }
+
+  for (auto &task : tasks) {
+    for (int predecessor : task.predecessors) {
+      auto found = indexById.find(predecessor);
+      if (found == indexById.end() ||
+          tasks[found->second].period != task.period) {
+        RTOS_LOG(ERROR, SCHEDULER, "Task ", task.id, " depends on Task ",
+                 predecessor, " which is missing or has another period");
+        return false;
+      }
+    }
+  }
+
+  // Алгоритм Кана; оставшиеся без ранга задачи образуют цикл
+  rank.assign(tasks.size(), -1);
+  for (int level = 0, assigned = 0; assigned < static_cast<int>(tasks.size());
+       ++level) {
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      if (rank[i] >= 0) {
+        continue;
+      }
+      bool free = true;
+      for (int predecessor : tasks[i].predecessors) {
+        int other = rank[indexById[predecessor]];
+        free = free && other >= 0 && other < level;
+      }
+      if (free) {
+        ready.push_back(i);
+      }
+    }
+
+    if (ready.empty()) {
+      RTOS_LOG(ERROR, SCHEDULER, "Precedence constraints form a cycle");
+      return false;
+    }
+    for (size_t i : ready) {
+      rank[i] = level;
+    }
+    assigned += static_cast<int>(ready.size());
+  }
+  return true;
+}
+
+bool assign(const std::vector<CyclicTaskParameters> &tasks,
+            const std::map<int, size_t> &indexById,
+            const std::vector<Job> &jobs, long long hyperperiod,
+            long long frameSize, CyclicSchedule &schedule) {
+  size_t frameCount = static_cast<size_t>(hyperperiod / frameSize);
+  std::vector<long long> load(frameCount, 0);
+  std::vector<std::vector<int>> frames(frameCount);
+  // Кадр каждого задания для учёта предшествования
+  std::vector<std::vector<long long>> frameOf(tasks.size());
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    frameOf[i].assign(hyperperiod / tasks[i].period, 0);
+  }
+
+  for (auto &job : jobs) {
+    const CyclicTaskParameters &task = tasks[job.task];
+    long long first = (job.release + frameSize - 1) / frameSize;
+    long long last = job.deadline / frameSize - 1;
+    for (int predecessor : task.predecessors) {
+      first = std::max(first, frameOf[indexById.at(predecessor)][job.index]);
+    }
+
+    long long frame = first;
+    while (frame <= last && load[frame] + task.wcet > frameSize)
+      frame++;
+    if (frame > last) {
+      return false;
+    }
+
+    load[frame] += task.wcet;
+    frames[frame].push_back(task.id);
+    frameOf[job.task][job.index] = frame;
+  }
+
+  schedule.hyperperiod = static_cast<int>(hyperperiod);
+  schedule.frameSize = static_cast<int>(frameSize);
+  schedule.frames = frames;
+  return true;
+}
+
+} // namespace
+
+bool buildCyclicSchedule(const std::vector<CyclicTaskParameters> &tasks,
+                         CyclicSchedule &schedule) {
+  std::map<int, size_t> indexById;
+  std::vector<int> rank;
+  long long hyperperiod = 0;
+  if (!validate(tasks, indexById, rank, hyperperiod)) {
+    return false;
+  }
+
+  std::vector<Job> jobs;
+  long long maxWcet = 0;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    maxWcet = std::max<long long>(maxWcet, tasks[i].wcet);
+    for (long long j = 0; j < hyperperiod / tasks[i].period; ++j) {
+      jobs.push_back({i, static_cast<int>(j), j * tasks[i].period,
+                      (j + 1) * tasks[i].period});
+    }
+    if (static_cast<long long>(jobs.size()) > MAX_JOBS) {
+      RTOS_LOG(ERROR, SCHEDULER, "Cyclic schedule exceeds ", MAX_JOBS,
+               " jobs per hyperperiod");
+      return false;
+    }
+  }
+
+  // По сроку, затем по предшествованию
+  std::sort(jobs.begin(), jobs.end(), [&](const Job &a, const Job &b) {
+    if (a.deadline != b.deadline)
+      return a.deadline < b.deadline;
+    if (rank[a.task] != rank[b.task])
+      return rank[a.task] < rank[b.task];
+    return a.task < b.task;
+  });
+
+  // Допустимые длины кадра, от наибольшей
+  std::vector<long long> frameSizes;
+  for (long long f = 1; f * f <= hyperperiod; ++f) {
+    if (hyperperiod % f == 0) {
+      frameSizes.push_back(f);
+      frameSizes.push_back(hyperperiod / f);
+    }
+  }
+  std::sort(frameSizes.rbegin(), frameSizes.rend());
+  frameSizes.erase(std::unique(frameSizes.begin(), frameSizes.end()),
+                   frameSizes.end());
+
+  for (long long f : frameSizes) {
+    bool valid = f >= maxWcet;
+    for (auto &task : tasks) {
+      valid = valid && 2 * f - gcd(task.period, f) <= task.period;
+    }
+
+    if (valid && assign(tasks, indexById, jobs, hyperperiod, f, schedule)) {
+      RTOS_LOG(INFO, SCHEDULER, "Cyclic schedule built: hyperperiod ",
+               hyperperiod, " ms, frame ", f, " ms, ",
+               schedule.frames.size(), " frames");
+      return true;
+    }
+  }
+
+  RTOS_LOG(ERROR, SCHEDULER, "No feasible cyclic schedule for the task set");
+  return false;
+}
+
+bool verifyCyclicSchedule(const std::vector<CyclicTaskParameters> &tasks,
+                          const CyclicSchedule &schedule) {
+  std::map<int, size_t> indexById;
+  std::vector<int> rank;
+  long long hyperperiod = 0;
+  if (!validate(tasks, indexById, rank, hyperperiod)) {
+    return false;
+  }
+
+  long long f = schedule.frameSize;
+  if (schedule.hyperperiod != hyperperiod || f <= 0 ||
+      static_cast<long long>(schedule.frames.size()) * f != hyperperiod) {
+    RTOS_LOG(ERROR, SCHEDULER, "Cyclic schedule does not match hyperperiod ",
+             hyperperiod, " ms of the task set");
+    return false;
+  }
+
+  // Порядковый номер запуска каждого задания: кадр и позиция в кадре
+  std::vector<std::vector<long long>> order(tasks.size());
+  for (size_t frame = 0; frame < schedule.frames.size(); ++frame) {
+    long long load = 0;
+    for (size_t position = 0; position < schedule.frames[frame].size();
+         ++position) {
+      int id = schedule.frames[frame][position];
+      auto found = indexById.find(id);
+      if (found == indexById.end()) {
+        RTOS_LOG(ERROR, SCHEDULER, "Cyclic schedule refers to unknown Task ",
+                 id);
+        return false;
+      }
+
+      const CyclicTaskParameters &task = tasks[found->second];
+      long long job = static_cast<long long>(order[found->second].size());
+      long long start = static_cast<long long>(frame) * f;
+      if (start < job * task.period || start + f > (job + 1) * task.period) {
+        RTOS_LOG(ERROR, SCHEDULER, "Job ", job, " of Task ", id,
+                 " is outside its window in frame ", frame);
+        return false;
+      }
+
+      load += task.wcet;
+      order[found->second].push_back(static_cast<long long>(frame) * INT_MAX +
+                                     static_cast<long long>(position));
+    }
+
+    if (load > f) {
+      RTOS_LOG(ERROR, SCHEDULER, "Frame ", frame, " is overloaded: ", load,
+               " ms in a ", f, " ms frame");
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    if (static_cast<long long>(order[i].size()) !=
+        hyperperiod / tasks[i].period) {
+      RTOS_LOG(ERROR, SCHEDULER, "Task ", tasks[i].id, " has ",
+               order[i].size(), " jobs in the cyclic schedule instead of ",
+               hyperperiod / tasks[i].period);
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    for (int predecessor : tasks[i].predecessors) {
+      const auto &before = order[indexById[predecessor]];
+      for (size_t job = 0; job < order[i].size(); ++job) {
+        if (before[job] >= order[i][job]) {
+          RTOS_LOG(ERROR, SCHEDULER, "Job ", job, " of Task ", tasks[i].id,
+                   " runs before its predecessor Task ", predecessor);
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+std::string exportCyclicSchedule(const CyclicSchedule &schedule) {
+  std::ostringstream out;
+  out << "# RTOS cyclic schedule\n";
+  out << "hyperperiod " << schedule.hyperperiod << "\n";
+  out << "frame_size " << schedule.frameSize << "\n";
+  for (size_t frame = 0; frame < schedule.frames.size(); ++frame) {
+    out << frame << ":";
+    for (int id : schedule.frames[frame]) {
+      out << " " << id;
+    }
+    out << "\n";
+  }
+  return out.str();
+}
+
+bool importCyclicSchedule(const std::string &text, CyclicSchedule &schedule) {
+  CyclicSchedule result;
+  std::istringstream in(text);
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::istringstream fields(line);
+    std::string key;
+    fields >> key;
+    if (key == "hyperperiod") {
+      fields >> result.hyperperiod;
+    } else if (key == "frame_size") {
+      fields >> result.frameSize;
+    } else if (!key.empty() && key.back() == ':') {
+      // Кадры перечисляются подряд, начиная с нулевого
+      std::istringstream number(key.substr(0, key.size() - 1));
+      size_t frame = 0;
+      if (!(number >> frame) || frame != result.frames.size()) {
+        RTOS_LOG(ERROR, SCHEDULER, "Unexpected frame ", key,
+                 " in cyclic schedule");
+        return false;
+      }
+      result.frames.emplace_back();
+      int id;
+      while (fields >> id) {
+        result.frames.back().push_back(id);
+      }
+    } else {
+      RTOS_LOG(ERROR, SCHEDULER, "Unexpected line in cyclic schedule: ",
+               line);
+      return false;
+    }
+
+    if (fields.fail() && !fields.eof()) {
+      RTOS_LOG(ERROR, SCHEDULER, "Malformed line in cyclic schedule: ",
+               line);
+      return false;
+    }
+  }
+
+  if (result.hyperperiod <= 0 || result.frameSize <= 0 ||
+      result.frames.empty()) {
+    RTOS_LOG(ERROR, SCHEDULER, "Cyclic schedule is incomplete");
+    return false;
+  }
+
+  schedule = result;
+  return true;
+}
+
+} // namespace RTOS
@@ -0,0 +1,152 @@
+// deadlock_detector.cpp
+#include "../include/deadlock_detector.h"
+#include "../include/semaphore.h"
+#include "../include/task.h"
+#include <algorithm>
+#include <string>
+
+namespace RTOS {
+
+DeadlockDetector::DeadlockDetector()
+    : enabled(false), lastCycleLength(0), detectedCount(0) {
+  reset();
+}
+
+void DeadlockDetector::reset() {
+  for (auto &holders : heldBy)
+    holders.store(0);
+  for (auto &resource : waitsFor)
+    resource.store(-1);
+}
+
+void DeadlockDetector::setEnabled(bool state) {
+  std::lock_guard<std::mutex> lock(waitMutex);
+  // Граф не ведётся при выключенном детекторе, поэтому при смене режима
+  // он сбрасывается целиком
+  reset();
+  enabled.store(state, std::memory_order_relaxed);
+}
+
+// Ресурс не может быть освобождён без продвижения задачи taskId, если
+// каждый его держатель - сама задача либо задача, заблокированная на таком
+// же ресурсе. Для считающих семафоров это исключает ложные срабатывания,
+// когда хотя бы один держатель ещё способен освободить единицы. path -
+// маска ресурсов текущего пути; via[r] - держатель, через которого цикл
+// продолжается от ресурса r, -1 - ресурс удерживает только сама задача.
+bool DeadlockDetector::isBlockedOn(int taskId, int resourceId,
+                                   std::uint32_t path, int *via) const {
+  std::uint32_t bit = 1u << resourceId;
+  if (path & bit) {
+    return true;
+  }
+
+  std::uint32_t held = heldBy[resourceId].load();
+  if (held == 0) {
+    return false;
+  }
+
+  via[resourceId] = -1;
+  std::uint32_t others = held & ~(1u << taskId);
+  for (int holder = 0; others; ++holder, others >>= 1) {
+    if (!(others & 1u)) {
+      continue;
+    }
+
+    int next = waitsFor[holder].load();
+    if (next < 0 || !isBlockedOn(taskId, next, path | bit, via)) {
+      return false;
+    }
+    if (via[resourceId] < 0) {
+      via[resourceId] = holder;
+    }
+  }
+  return true;
+}
+
+bool DeadlockDetector::onWait(const Task *task, const Semaphore *resource) {
+  if (!isEnabled()) {
+    return true;
+  }
+
+  int taskId = task->getId();
+  int resourceId = resource->getId();
+  std::lock_guard<std::mutex> lock(waitMutex);
+
+  int via[MAX_RESOURCES];
+  std::fill(via, via + MAX_RESOURCES, -1);
+  if (!isBlockedOn(taskId, resourceId, 0, via)) {
+    waitsFor[taskId].store(resourceId);
+    return true;
+  }
+
+  // Цикл восстанавливается по держателям, через которых он прошёл
+  lastCycleLength = 0;
+  lastCycle[lastCycleLength++] = {taskId, resourceId};
+  std::uint32_t visited = 1u << resourceId;
+  for (int r = resourceId; via[r] >= 0;) {
+    int next = waitsFor[via[r]].load();
+    lastCycle[lastCycleLength++] = {via[r], next};
+    if (next < 0 || (visited & (1u << next))) {
+      break;
+    }
+    visited |= 1u << next;
+    r = next;
+  }
+  detectedCount++;
+
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_ERROR
+  // Описание цикла собирается, только если запись сохраняется
+  if (SystemLog::isEnabled(LOG_DEADLOCK)) {
+    std::string description;
+    for (int i = 0; i < lastCycleLength; ++i) {
+      description += "Task " + std::to_string(lastCycle[i].taskId) +
+                     " -> semaphore " +
+                     std::to_string(lastCycle[i].semaphoreId) + " -> ";
+    }
+    description += "Task " + std::to_string(taskId);
+    RTOS_LOG(ERROR, DEADLOCK, "Deadlock detected: ", description);
+  }
+#endif
+  return false;
+}
+
+void DeadlockDetector::onWaitEnded(const Task *task) {
+  if (!isEnabled()) {
+    return;
+  }
+  waitsFor[task->getId()].store(-1);
+}
+
+void DeadlockDetector::onAcquired(const Task *task, const Semaphore *resource) {
+  if (!isEnabled()) {
+    return;
+  }
+  waitsFor[task->getId()].store(-1);
+  heldBy[resource->getId()].fetch_or(1u << task->getId());
+}
+
+void DeadlockDetector::onReleased(const Task *task, const Semaphore *resource) {
+  if (!isEnabled()) {
+    return;
+  }
+  heldBy[resource->getId()].fetch_and(~(1u << task->getId()));
+}
+
+void DeadlockDetector::forgetTask(const Task *task) {
+  std::uint32_t bit = 1u << task->getId();
+  waitsFor[task->getId()].store(-1);
+  for (auto &holders : heldBy)
+    holders.fetch_and(~bit);
+}
+
+std::vector<WaitForEdge> DeadlockDetector::getLastCycle() {
+  std::lock_guard<std::mutex> lock(waitMutex);
+  return std::vector<WaitForEdge>(lastCycle, lastCycle + lastCycleLength);
+}
+
+int DeadlockDetector::getDetectedCount() {
+  std::lock_guard<std::mutex> lock(waitMutex);
+  return detectedCount;
+}
+
+} // namespace RTOS
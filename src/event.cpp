@@ -1,10 +1,18 @@
 // event.cpp
 #include "../include/event.h"
+#include "../include/futex.h"
+#include "../include/scheduler.h"
+#include <algorithm>
+#include <climits>
 
 namespace RTOS {
 
+using Clock = std::chrono::steady_clock;
+
 Event::Event(int id, Task *owner)
-    : id(id), owner(owner), triggered(false), logger(SystemLog::getInstance()) {
+    : id(id), owner(owner), triggered(false), generation(0), sleepers(0),
+      expiredWaits(0), signalledWaits(0),
+      nextDeadline(Clock::time_point::max().time_since_epoch().count()) {
   if (owner) {
     owner->addEvent(this);
   }
@@ -16,33 +24,170 @@ Task *Event::getOwner() const { return owner; }
 
 void Event::trigger() {
   if (owner) {
-    triggered = true;
-    logger.logEvent("Event " + std::to_string(id) + " triggered by Task " +
-                    std::to_string(owner->getId()));
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      triggered = true;
+      generation++;
+      RTOS_LOG(DEBUG, EVENT, "Event ", id, " triggered by Task ",
+               owner->getId());
 
-    for (auto task : waitingTasks) {
-      task->setReady(true);
-      logger.logEvent("Task " + std::to_string(task->getId()) +
-                      " woken up by event " + std::to_string(id));
+      for (auto &waiter : waitingTasks) {
+        if (!waiter.sleeping && waiter.deadline != Clock::time_point::max()) {
+          signalledWaits |= 1u << waiter.task->getId();
+        }
+        waiter.task->setReady(true);
+        RTOS_LOG(DEBUG, EVENT, "Task ", waiter.task->getId(),
+                 " woken up by event ", id);
+      }
+      waitingTasks.clear();
+    }
+
+    if (sleepers.load() > 0) {
+      futexWake(&generation, INT_MAX);
     }
-    waitingTasks.clear();
   }
 }
 
 void Event::reset() {
   triggered = false;
-  logger.logEvent("Event " + std::to_string(id) + " reset");
+  RTOS_LOG(DEBUG, EVENT, "Event ", id, " reset");
 }
 
 bool Event::isTriggered() const { return triggered; }
 
 void Event::waitFor(Task *task) {
+  TaskCall call(task);
+  if (!call.isEntered()) {
+    RTOS_LOG(ERROR, EVENT, "Destroyed Task ", task->getId(),
+             " cannot wait for event ", id);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mtx);
   if (!triggered && task != owner) {
-    waitingTasks.push_back(task);
+    expiredWaits &= ~(1u << task->getId());
+    waitingTasks.push_back({task, false, Clock::time_point::max()});
     task->setReady(false);
-    logger.logEvent("Task " + std::to_string(task->getId()) +
-                    " waiting for event " + std::to_string(id));
+    RTOS_LOG(DEBUG, EVENT, "Task ", task->getId(), " waiting for event ", id);
+  }
+}
+
+bool Event::waitFor(Task *task, std::chrono::milliseconds timeout) {
+  auto deadline = Clock::now() + timeout;
+  TaskCall call(task);
+  if (!call.isEntered()) {
+    RTOS_LOG(ERROR, EVENT, "Destroyed Task ", task->getId(),
+             " cannot wait for event ", id);
+    return false;
+  }
+  std::unique_lock<std::mutex> lock(mtx);
+  std::uint32_t bit = 1u << task->getId();
+
+  if (triggered || (signalledWaits & bit)) {
+    expiredWaits &= ~bit;
+    signalledWaits &= ~bit;
+    return true;
+  }
+  if (task == owner) {
+    return false;
+  }
+
+  // В потоке планировщика задача только перестаёт быть готовой, см.
+  // Semaphore::acquire
+  if (Scheduler::isDispatchThread()) {
+    if (expiredWaits & bit) {
+      expiredWaits &= ~bit;
+      return false;
+    }
+    if (timeout.count() > 0) {
+      waitingTasks.push_back({task, false, deadline});
+      task->setReady(false);
+      if (deadline.time_since_epoch().count() < nextDeadline) {
+        nextDeadline = deadline.time_since_epoch().count();
+      }
+      RTOS_LOG(DEBUG, EVENT, "Task ", task->getId(), " waiting for event ",
+               id, " with timeout");
+    }
+    return false;
+  }
+
+  if (timeout.count() <= 0) {
+    return false;
+  }
+
+  int observed = generation.load();
+  waitingTasks.push_back({task, true, Clock::time_point::max()});
+  task->setReady(false);
+  RTOS_LOG(DEBUG, EVENT, "Task ", task->getId(), " waiting for event ", id,
+           " with timeout");
+
+  while (true) {
+    sleepers++;
+    lock.unlock();
+
+    auto now = Clock::now();
+    if (now < deadline) {
+      futexWait(&generation, observed, deadline - now);
+    }
+
+    lock.lock();
+    sleepers--;
+
+    // trigger() уже снял задачу с очереди и сделал её готовой
+    if (generation.load() != observed) {
+      return true;
+    }
+
+    if (Clock::now() >= deadline) {
+      waitingTasks.erase(std::remove_if(waitingTasks.begin(),
+                                        waitingTasks.end(),
+                                        [task](const Waiter &w) {
+                                          return w.task == task;
+                                        }),
+                         waitingTasks.end());
+      task->setReady(true);
+      RTOS_LOG(DEBUG, EVENT, "Task ", task->getId(),
+               " timed out waiting for event ", id);
+      return false;
+    }
   }
 }
 
+void Event::cancelWait(Task *task) {
+  std::lock_guard<std::mutex> lock(mtx);
+  expiredWaits &= ~(1u << task->getId());
+  signalledWaits &= ~(1u << task->getId());
+  waitingTasks.erase(
+      std::remove_if(waitingTasks.begin(), waitingTasks.end(),
+                     [task](const Waiter &w) { return w.task == task; }),
+      waitingTasks.end());
+}
+
+Clock::time_point Event::expireWaits(Clock::time_point now) {
+  Clock::time_point next(Clock::duration(nextDeadline.load()));
+  if (now < next) {
+    return next;
+  }
+
+  std::lock_guard<std::mutex> lock(mtx);
+  next = Clock::time_point::max();
+  for (auto it = waitingTasks.begin(); it != waitingTasks.end();) {
+    if (it->sleeping || it->deadline > now) {
+      if (!it->sleeping) {
+        next = std::min(next, it->deadline);
+      }
+      ++it;
+      continue;
+    }
+
+    expiredWaits |= 1u << it->task->getId();
+    it->task->setReady(true);
+    RTOS_LOG(DEBUG, EVENT, "Task ", it->task->getId(),
+             " timed out waiting for event ", id);
+    it = waitingTasks.erase(it);
+  }
+
+  nextDeadline = next.time_since_epoch().count();
+  return next;
+}
+
 } // namespace RTOS
@@ -0,0 +1,67 @@
+// futex.cpp
+#include "../include/futex.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace RTOS {
+
+static_assert(sizeof(std::atomic<int>) == sizeof(int),
+              "futex word must be a plain 32-bit integer");
+
+#ifdef __linux__
+
+bool futexWait(std::atomic<int> *word, int expected,
+               std::chrono::nanoseconds timeout, bool shared) {
+  if (timeout.count() <= 0) {
+    return false;
+  }
+
+  struct timespec ts;
+  ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+  ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+
+  int op = shared ? FUTEX_WAIT : (FUTEX_WAIT | FUTEX_PRIVATE_FLAG);
+  long result = syscall(SYS_futex, reinterpret_cast<int *>(word), op,
+                        expected, &ts, nullptr, 0);
+  return !(result == -1 && errno == ETIMEDOUT);
+}
+
+void futexWake(std::atomic<int> *word, int count, bool shared) {
+  int op = shared ? FUTEX_WAKE : (FUTEX_WAKE | FUTEX_PRIVATE_FLAG);
+  syscall(SYS_futex, reinterpret_cast<int *>(word), op, count, nullptr,
+          nullptr, 0);
+}
+
+#else
+
+// Запасной вариант для платформ без futex: общая условная переменная.
+// Разделяемая между процессами память здесь не поддерживается.
+namespace {
+std::mutex futexMutex;
+std::condition_variable futexCv;
+} // namespace
+
+bool futexWait(std::atomic<int> *word, int expected,
+               std::chrono::nanoseconds timeout, bool) {
+  std::unique_lock<std::mutex> lock(futexMutex);
+  return futexCv.wait_for(lock, timeout,
+                          [&]() { return word->load() != expected; });
+}
+
+void futexWake(std::atomic<int> *, int, bool) {
+  { std::lock_guard<std::mutex> lock(futexMutex); }
+  futexCv.notify_all();
+}
+
+#endif
+
+} // namespace RTOS
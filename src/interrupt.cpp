@@ -0,0 +1,240 @@
+// interrupt.cpp
+#include "../include/interrupt.h"
+#include "../include/futex.h"
+
+namespace RTOS {
+
+InterruptController::InterruptController()
+    : allocated(0), registered(0), released(0), pending(0), detachedTasks(0),
+      wakeWord(0), sleeping(false) {
+  for (int irq = 0; irq < MAX_INTERRUPTS; ++irq) {
+    sources[irq].target = nullptr;
+    raisedAt[irq].store(0);
+    raisedCount[irq].store(0);
+    servicedCount[irq].store(0);
+    measuredCount[irq].store(0);
+    totalLatency[irq].store(0);
+    maxLatency[irq].store(0);
+  }
+  for (int id = 0; id < MAX_TASKS; ++id) {
+    targetRaisedAt[id] = 0;
+    targetSource[id] = -1;
+  }
+}
+
+std::int64_t InterruptController::now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int InterruptController::registerSource(std::function<void()> handler,
+                                        Task *target) {
+  std::lock_guard<std::mutex> lock(registerMutex);
+
+  int irq = 0;
+  while (irq < MAX_INTERRUPTS && (allocated & (1u << irq)))
+    irq++;
+
+  if (irq == MAX_INTERRUPTS) {
+    RTOS_LOG(ERROR, INTERRUPT, "Maximum number of interrupt sources reached");
+    return -1;
+  }
+
+  // Источник заполняется до публикации бита, поэтому поток планировщика
+  // видит его целиком
+  allocated |= 1u << irq;
+  sources[irq].handler = handler;
+  sources[irq].target = target;
+  raisedAt[irq].store(0);
+  raisedCount[irq].store(0);
+  servicedCount[irq].store(0);
+  measuredCount[irq].store(0);
+  totalLatency[irq].store(0);
+  maxLatency[irq].store(0);
+  registered.fetch_or(1u << irq);
+
+  if (target) {
+    RTOS_LOG(INFO, INTERRUPT, "Interrupt source ", irq, " registered for Task ",
+             target->getId());
+  } else {
+    RTOS_LOG(INFO, INTERRUPT, "Interrupt source ", irq, " registered");
+  }
+  return irq;
+}
+
+bool InterruptController::unregisterSource(int irq) {
+  std::lock_guard<std::mutex> lock(registerMutex);
+  if (irq < 0 || irq >= MAX_INTERRUPTS ||
+      !(registered.load() & (1u << irq))) {
+    RTOS_LOG(ERROR, INTERRUPT, "Interrupt source ", irq, " is not registered");
+    return false;
+  }
+
+  registered.fetch_and(~(1u << irq));
+  pending.fetch_and(~(1u << irq));
+  sources[irq].target = nullptr;
+  released.fetch_or(1u << irq);
+
+  RTOS_LOG(INFO, INTERRUPT, "Interrupt source ", irq, " unregistered");
+  return true;
+}
+
+void InterruptController::detachTask(Task *task) {
+  for (int irq = 0; irq < MAX_INTERRUPTS; ++irq) {
+    Task *expected = task;
+    if (sources[irq].target.compare_exchange_strong(expected, nullptr)) {
+      RTOS_LOG(INFO, INTERRUPT, "Interrupt source ", irq,
+               " detached from Task ", task->getId());
+    }
+  }
+  detachedTasks.fetch_or(1u << task->getId());
+}
+
+// Сброс состояния снятых источников и удалённых задач; поток планировщика
+// вне вызовов обработчиков
+void InterruptController::reclaim() {
+  for (std::uint32_t ids = detachedTasks.exchange(0); ids; ids &= ids - 1) {
+    int id = __builtin_ctz(ids);
+    targetRaisedAt[id] = 0;
+    targetSource[id] = -1;
+  }
+
+  std::uint32_t done = released.exchange(0);
+  if (!done) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(registerMutex);
+  for (std::uint32_t bits = done; bits; bits &= bits - 1) {
+    int irq = __builtin_ctz(bits);
+    sources[irq].handler = nullptr;
+    for (int id = 0; id < MAX_TASKS; ++id) {
+      if (targetSource[id] == irq) {
+        targetRaisedAt[id] = 0;
+        targetSource[id] = -1;
+      }
+    }
+  }
+  allocated &= ~done;
+}
+
+void InterruptController::raise(int irq) {
+  if (irq < 0 || irq >= MAX_INTERRUPTS ||
+      !(registered.load() & (1u << irq))) {
+    return;
+  }
+
+  // Сохраняется время первого из слившихся прерываний
+  std::int64_t expected = 0;
+  raisedAt[irq].compare_exchange_strong(expected, now());
+  raisedCount[irq].fetch_add(1);
+  pending.fetch_or(1u << irq);
+
+  wakeWord.fetch_add(1);
+  if (sleeping.load()) {
+    futexWake(&wakeWord, 1);
+  }
+}
+
+bool InterruptController::hasPending() const { return pending.load() != 0; }
+
+void InterruptController::recordLatency(int irq, std::int64_t raisedTime,
+                                        std::int64_t doneTime) {
+  if (raisedTime == 0 || doneTime < raisedTime) {
+    return;
+  }
+
+  std::uint64_t latency = static_cast<std::uint64_t>(doneTime - raisedTime);
+  measuredCount[irq].fetch_add(1);
+  totalLatency[irq].fetch_add(latency);
+  if (latency > maxLatency[irq].load()) {
+    maxLatency[irq].store(latency);
+  }
+}
+
+void InterruptController::dispatchPending() {
+  reclaim();
+  // Прерывания, выставленные одновременно со снятием источника, теряются
+  std::uint32_t bits = pending.exchange(0) & registered.load();
+
+  while (bits) {
+    int irq = __builtin_ctz(bits);
+    bits &= bits - 1;
+
+    std::int64_t raisedTime = raisedAt[irq].exchange(0);
+    Source &source = sources[irq];
+
+    if (source.handler) {
+      source.handler();
+    }
+    servicedCount[irq].fetch_add(1);
+
+    // Отвязанная задача после этой загрузки освобождается не раньше
+    // следующей точки диспетчеризации
+    Task *target = source.target.load();
+    if (target) {
+      int id = target->getId();
+      if (targetRaisedAt[id] == 0) {
+        targetRaisedAt[id] = raisedTime;
+        targetSource[id] = irq;
+      }
+      target->setReady(true);
+    } else {
+      recordLatency(irq, raisedTime, now());
+    }
+  }
+}
+
+void InterruptController::onTaskDispatched(const Task *task) {
+  int id = task->getId();
+  if (targetSource[id] < 0) {
+    return;
+  }
+
+  recordLatency(targetSource[id], targetRaisedAt[id], now());
+  targetRaisedAt[id] = 0;
+  targetSource[id] = -1;
+}
+
+void InterruptController::waitForInterrupt(std::chrono::nanoseconds timeout) {
+  sleeping.store(true);
+  int observed = wakeWord.load();
+  if (!hasPending()) {
+    futexWait(&wakeWord, observed, timeout);
+  }
+  sleeping.store(false);
+}
+
+InterruptStats InterruptController::getStats(int irq) const {
+  InterruptStats stats = {};
+  if (irq < 0 || irq >= MAX_INTERRUPTS) {
+    return stats;
+  }
+
+  stats.raised = raisedCount[irq].load();
+  stats.serviced = servicedCount[irq].load();
+  stats.measured = measuredCount[irq].load();
+  stats.totalLatencyNs = totalLatency[irq].load();
+  stats.maxLatencyNs = maxLatency[irq].load();
+  return stats;
+}
+
+void InterruptController::report() {
+  std::uint32_t used = registered.load();
+  for (int irq = 0; irq < MAX_INTERRUPTS; ++irq) {
+    if (!(used & (1u << irq))) {
+      continue;
+    }
+
+    InterruptStats stats = getStats(irq);
+    std::uint64_t average =
+        stats.measured ? stats.totalLatencyNs / stats.measured : 0;
+    RTOS_LOG(INFO, INTERRUPT, "Interrupt ", irq, ": raised ", stats.raised,
+             ", serviced ", stats.serviced, ", average latency ",
+             average / 1000, " us, max latency ", stats.maxLatencyNs / 1000,
+             " us");
+  }
+}
+
+} // namespace RTOS
@@ -5,127 +5,661 @@
 
 namespace RTOS {
 
-Scheduler::Scheduler() : logger(SystemLog::getInstance()), running(false) {
-  tasks.reserve(MAX_TASKS);
-  semaphores.reserve(MAX_RESOURCES);
-  events.reserve(MAX_EVENTS);
+namespace {
+
+thread_local bool dispatchThread = false;
+
+// Отмечает поток, выполняющий тела задач, на время диспетчеризации
+class DispatchThreadScope {
+private:
+  bool previous;
+
+public:
+  DispatchThreadScope() : previous(dispatchThread) { dispatchThread = true; }
+  ~DispatchThreadScope() { dispatchThread = previous; }
+};
+
+} // namespace
+
+Scheduler::Scheduler()
+    : taskTable(std::make_shared<TaskTable>()), tableEpoch(0),
+      quiescentEpoch(~0ull), usedTaskIds(0), running(false),
+      criticalityMode(Criticality::Low),
+      sheddingPolicy(SheddingPolicy::Drop), modeSwitches(0), droppedJobs(0),
+      schedulingMode(SchedulingMode::Priority), frameOverruns(0),
+      snapshotVersion(0), dispatchCount(0), dispatchOverheadNs(0),
+      maxDispatchOverheadNs(0),
+      nextWaitDeadline(std::chrono::steady_clock::time_point::max()) {
+  channels.reserve(MAX_CHANNELS);
 }
 
 Scheduler::~Scheduler() {
   stop();
-  for (auto task : tasks)
+  for (auto task : std::atomic_load(&taskTable)->tasks)
     delete task;
+  for (auto &retired : retiredTasks)
+    delete retired.task;
   for (auto semaphore : semaphores)
     delete semaphore;
   for (auto event : events)
     delete event;
+  for (auto channel : channels)
+    delete channel;
+}
+
+// Публикация новой таблицы; вызывается под tableMutex. Эпоха увеличивается
+// после подмены таблицы, поэтому планировщик, увидевший новую эпоху, уже
+// работает с новой таблицей.
+void Scheduler::publishTable(std::shared_ptr<TaskTable> table) {
+  table->members = 0;
+  table->byId.fill(nullptr);
+  for (auto task : table->tasks) {
+    table->members |= 1u << task->getId();
+    table->byId[task->getId()] = task;
+  }
+
+  std::atomic_store(&taskTable, std::shared_ptr<const TaskTable>(table));
+  tableEpoch++;
+}
+
+// Приоритеты по RMA: меньший период = выше приоритет
+void Scheduler::assignRmaPriorities(const TaskTable &table) {
+  for (size_t i = 0; i < table.tasks.size(); ++i) {
+    int rmaPriority = std::min(MAX_PRIORITIES - 1, static_cast<int>(i));
+    rmaPriority = MAX_PRIORITIES - 1 - rmaPriority;
+    Task *task = table.tasks[i];
+    if (task->getBasePriority() != rmaPriority) {
+      task->setBasePriority(rmaPriority);
+      RTOS_LOG(INFO, SCHEDULER, "Task ", task->getId(),
+               " RMA priority set to ", rmaPriority);
+    }
+  }
+}
+
+// Проверка допустимости анализом времени отклика для невытесняющего
+// планирования (analyzeAmcRtb): новая задача занимает позицию RMA, а
+// блокировка заданием задачи с меньшим приоритетом учитывается. Задачи без
+// известного времени выполнения в анализ не входят, а новая такая задача
+// принимается без проверки, поэтому гарантия относится только к задачам с
+// известным временем выполнения.
+bool Scheduler::admit(const TaskTable &table, int period, int wcet) {
+  if (wcet <= 0) {
+    return true;
+  }
+
+  if (period <= 0 || wcet > period) {
+    return false;
+  }
+
+  std::vector<TaskParameters> parameters;
+  const TaskParameters candidate{period, wcet, wcet, Criticality::Low};
+  bool inserted = false;
+  for (auto task : table.tasks) {
+    if (!inserted && period < task->getPeriod()) {
+      parameters.push_back(candidate);
+      inserted = true;
+    }
+    if (task->getWcet() > 0 && task->getPeriod() > 0) {
+      parameters.push_back({task->getPeriod(), task->getWcet(Criticality::Low),
+                            task->getWcet(Criticality::High),
+                            task->getCriticality()});
+    }
+  }
+  if (!inserted) {
+    parameters.push_back(candidate);
+  }
+
+  std::vector<ResponseTime> result;
+  return analyzeAmcRtb(parameters, result);
+}
+
+// Освобождение удалённых задач после прохождения планировщиком точки
+// диспетчеризации; вызывается под tableMutex
+void Scheduler::reclaimRetiredTasks() {
+  std::uint64_t quiescent = quiescentEpoch.load();
+  for (auto it = retiredTasks.begin(); it != retiredTasks.end();) {
+    if (it->epoch <= quiescent) {
+      usedTaskIds &= ~(1u << it->task->getId());
+      delete it->task;
+      it = retiredTasks.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
 Task *Scheduler::createTask(int priority, int period,
-                            std::function<void()> taskFunction) {
-  if (tasks.size() >= MAX_TASKS) {
-    logger.logEvent("ERROR: Maximum number of tasks reached");
+                            std::function<void()> taskFunction, int wcet) {
+  std::lock_guard<std::mutex> lock(tableMutex);
+  reclaimRetiredTasks();
+
+  if (running && schedulingMode == SchedulingMode::Cyclic) {
+    RTOS_LOG(ERROR, SCHEDULER,
+             "Task set is fixed while the cyclic schedule runs");
+    return nullptr;
+  }
+
+  // Наименьший свободный id
+  int id = 0;
+  while (id < MAX_TASKS && (usedTaskIds & (1u << id)))
+    id++;
+
+  if (id == MAX_TASKS) {
+    RTOS_LOG(ERROR, SCHEDULER, "Maximum number of tasks reached");
     return nullptr;
   }
 
   if (priority >= MAX_PRIORITIES) {
-    logger.logEvent("ERROR: Priority exceeds maximum allowed");
+    RTOS_LOG(ERROR, SCHEDULER, "Priority exceeds maximum allowed");
+    return nullptr;
+  }
+
+  auto current = std::atomic_load(&taskTable);
+  if (!admit(*current, period, wcet)) {
+    RTOS_LOG(ERROR, SCHEDULER, "Task with period ", period, " and WCET ",
+             wcet, " rejected by admission control");
     return nullptr;
   }
 
-  int id = static_cast<int>(tasks.size());
-  Task *task = new Task(id, priority, period, taskFunction);
-  tasks.push_back(task);
+  usedTaskIds |= 1u << id;
 
-  logger.logEvent("Task " + std::to_string(id) + " created with priority " +
-                  std::to_string(priority) + " and period " +
-                  std::to_string(period));
+  Task *task = new Task(controlBlocks, id, priority, period, taskFunction);
+  task->setWcet(wcet);
+
+  // Вставка в позицию RMA; задачи с равным периодом сохраняют порядок
+  // создания
+  auto table = std::make_shared<TaskTable>(*current);
+  auto position = std::upper_bound(
+      table->tasks.begin(), table->tasks.end(), period,
+      [](int p, Task *t) { return p < t->getPeriod(); });
+  table->tasks.insert(position, task);
+
+  RTOS_LOG(INFO, SCHEDULER, "Task ", id, " created with priority ", priority,
+           " and period ", period);
+
+  if (running) {
+    assignRmaPriorities(*table);
+  }
+  publishTable(table);
 
   return task;
 }
 
-Semaphore *Scheduler::createSemaphore() {
-  if (semaphores.size() >= MAX_RESOURCES) {
-    logger.logEvent("ERROR: Maximum number of semaphores reached");
+bool Scheduler::destroyTask(Task *task) {
+  std::lock_guard<std::mutex> lock(tableMutex);
+
+  if (running && schedulingMode == SchedulingMode::Cyclic) {
+    RTOS_LOG(ERROR, SCHEDULER,
+             "Task set is fixed while the cyclic schedule runs");
+    return false;
+  }
+
+  auto current = std::atomic_load(&taskTable);
+  auto position =
+      std::find(current->tasks.begin(), current->tasks.end(), task);
+  if (position == current->tasks.end()) {
+    RTOS_LOG(ERROR, SCHEDULER, "Task is not registered in the scheduler");
+    return false;
+  }
+
+  // Задача может выполняться в потоке планировщика прямо сейчас. После
+  // retire() её тело уже не захватит семафор и не встанет в очередь, а
+  // вызов, начатый раньше, не даст удалить задачу, поэтому проверки ниже
+  // не устаревают
+  if (!task->retire()) {
+    RTOS_LOG(ERROR, SCHEDULER, "Task ", task->getId(),
+             " cannot be destroyed during a kernel call on its behalf");
+    return false;
+  }
+
+  for (auto semaphore : semaphores) {
+    if (semaphore->getHeldUnits(task) > 0) {
+      task->restore();
+      RTOS_LOG(ERROR, SCHEDULER, "Task ", task->getId(),
+               " cannot be destroyed while holding semaphore ",
+               semaphore->getId());
+      return false;
+    }
+  }
+
+  if (!task->getEvents().empty()) {
+    task->restore();
+    RTOS_LOG(ERROR, SCHEDULER, "Task ", task->getId(),
+             " cannot be destroyed while owning events");
+    return false;
+  }
+
+  for (auto semaphore : semaphores)
+    semaphore->cancelWait(task);
+  for (auto event : events)
+    event->cancelWait(task);
+  interrupts.detachTask(task);
+  task->setReady(false);
+  deadlocks.forgetTask(task);
+  for (auto other : current->tasks)
+    other->removePredecessor(task);
+
+  auto table = std::make_shared<TaskTable>(*current);
+  table->tasks.erase(table->tasks.begin() +
+                     (position - current->tasks.begin()));
+  if (running) {
+    assignRmaPriorities(*table);
+  }
+  publishTable(table);
+
+  retiredTasks.push_back({task, tableEpoch.load()});
+  RTOS_LOG(INFO, SCHEDULER, "Task ", task->getId(), " destroyed");
+
+  reclaimRetiredTasks();
+  return true;
+}
+
+Semaphore *Scheduler::createSemaphore(int initialCount) {
+  std::lock_guard<std::mutex> lock(resourceMutex);
+  if (semaphores.full()) {
+    RTOS_LOG(ERROR, SCHEDULER, "Maximum number of semaphores reached");
+    return nullptr;
+  }
+
+  if (initialCount <= 0) {
+    RTOS_LOG(ERROR, SCHEDULER, "Semaphore count must be positive");
     return nullptr;
   }
 
-  Semaphore *semaphore = new Semaphore();
-  semaphores.push_back(semaphore);
+  int id = semaphores.size();
+  Semaphore *semaphore =
+      new Semaphore(id, initialCount, &semaphores, &deadlocks);
+  semaphores.push(semaphore);
 
-  logger.logEvent("Semaphore " + std::to_string(semaphores.size() - 1) +
-                  " created");
+  RTOS_LOG(INFO, SCHEDULER, "Semaphore ", id, " created with count ",
+           initialCount);
 
   return semaphore;
 }
 
 Event *Scheduler::createEvent(Task *owner) {
-  if (events.size() >= MAX_EVENTS) {
-    logger.logEvent("ERROR: Maximum number of events reached");
+  std::lock_guard<std::mutex> lock(resourceMutex);
+  if (events.full()) {
+    RTOS_LOG(ERROR, SCHEDULER, "Maximum number of events reached");
     return nullptr;
   }
 
-  int id = static_cast<int>(events.size());
+  int id = events.size();
   Event *event = new Event(id, owner);
-  events.push_back(event);
+  events.push(event);
 
-  logger.logEvent(
-      "Event " + std::to_string(id) + " created" +
-      (owner ? " owned by Task " + std::to_string(owner->getId()) : ""));
+  if (owner) {
+    RTOS_LOG(INFO, SCHEDULER, "Event ", id, " created owned by Task ",
+             owner->getId());
+  } else {
+    RTOS_LOG(INFO, SCHEDULER, "Event ", id, " created");
+  }
 
   return event;
 }
 
+Channel *Scheduler::createChannel(const std::string &name, int slotSize,
+                                  int slotCount) {
+  if (channels.size() >= MAX_CHANNELS) {
+    RTOS_LOG(ERROR, SCHEDULER, "Maximum number of channels reached");
+    return nullptr;
+  }
+
+  Channel *channel = new Channel(static_cast<int>(channels.size()), interrupts);
+  if (!channel->create(name, slotSize, slotCount)) {
+    delete channel;
+    return nullptr;
+  }
+
+  channels.push_back(channel);
+  return channel;
+}
+
+Channel *Scheduler::openChannel(const std::string &name) {
+  if (channels.size() >= MAX_CHANNELS) {
+    RTOS_LOG(ERROR, SCHEDULER, "Maximum number of channels reached");
+    return nullptr;
+  }
+
+  Channel *channel = new Channel(static_cast<int>(channels.size()), interrupts);
+  if (!channel->open(name)) {
+    delete channel;
+    return nullptr;
+  }
+
+  channels.push_back(channel);
+  return channel;
+}
+
 void Scheduler::start() {
   if (running)
     return;
 
-  running = true;
-  logger.logEvent("Scheduler started");
-
-  // Сортировка задач согласно RMA (меньший период = выше приоритет)
-  std::sort(tasks.begin(), tasks.end(),
-            [](Task *a, Task *b) { return a->getPeriod() < b->getPeriod(); });
-
-  // Обновление приоритетов на основе RMA
+  if (schedulingMode == SchedulingMode::Cyclic) {
+    // Заранее загруженная таблица проверяется на текущем наборе задач
+    bool ready = cyclicSchedule.frames.empty()
+                     ? buildCyclicSchedule()
+                     : verifyCyclicSchedule(cyclicParameters(), cyclicSchedule);
+    if (!ready) {
+      RTOS_LOG(ERROR, SCHEDULER,
+               "Scheduler not started: no valid cyclic schedule");
+      return;
+    }
+  }
 
-  for (size_t i = 0; i < tasks.size(); ++i) {
-    int rmaPriority = std::min(MAX_PRIORITIES - 1, static_cast<int>(i));
-    rmaPriority = MAX_PRIORITIES - 1 - rmaPriority;
-    tasks[i]->setPriority(rmaPriority);
-    logger.logEvent("Task " + std::to_string(tasks[i]->getId()) +
-                    " RMA priority set to " + std::to_string(rmaPriority));
+  running = true;
+  RTOS_LOG(INFO, SCHEDULER, "Scheduler started");
+
+  {
+    std::lock_guard<std::mutex> lock(tableMutex);
+    // Таблица уже упорядочена по RMA, остаётся назначить приоритеты
+    auto table = std::atomic_load(&taskTable);
+    assignRmaPriorities(*table);
+    quiescentEpoch = tableEpoch.load();
+    publishSnapshot(*table, -1);
   }
 
   // Запуск планировщика в отдельном потоке
-  schedulerThread = std::thread([this]() { this->schedulerLoop(); });
+  if (schedulingMode == SchedulingMode::Cyclic) {
+    schedulerThread = std::thread([this]() { this->cyclicLoop(); });
+  } else {
+    schedulerThread = std::thread([this]() { this->schedulerLoop(); });
+  }
 }
 
 void Scheduler::schedulerLoop() {
+  DispatchThreadScope scope;
   while (running) {
-    // Поиск готовой задачи с наивысшим приоритетом (без вытеснения)
-    Task *selectedTask = nullptr;
-
-    for (auto task : tasks) {
-      if (task->isReady()) {
-        if (!selectedTask ||
-            task->getPriority() > selectedTask->getPriority()) {
-          selectedTask = task;
-        }
+    // Точка диспетчеризации: подхватываем актуальную таблицу и сообщаем,
+    // что более старые таблицы планировщику больше не нужны
+    std::uint64_t epoch = tableEpoch.load();
+    std::shared_ptr<const TaskTable> table = std::atomic_load(&taskTable);
+    quiescentEpoch = epoch;
+
+    if (!dispatch(*table)) {
+      // Нет готовых задач: ждём прерывания, но не дольше 10 мс и не
+      // дольше ближайшего срока ожидания
+      std::chrono::nanoseconds timeout = std::chrono::milliseconds(10);
+      auto now = std::chrono::steady_clock::now();
+      if (nextWaitDeadline < now + timeout) {
+        timeout = std::max(std::chrono::nanoseconds(0),
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               nextWaitDeadline - now));
       }
+      interrupts.waitForInterrupt(timeout);
     }
+  }
+
+  // Планировщик больше не обращается ни к одной таблице
+  quiescentEpoch = ~0ull;
+}
 
-    if (selectedTask) {
-      logger.logEvent("Task " + std::to_string(selectedTask->getId()) +
-                      " selected for execution");
-      selectedTask->execute();
-      logger.logEvent("Task " + std::to_string(selectedTask->getId()) +
-                      " completed execution");
+// Одна точка диспетчеризации; false, если выполнять было нечего. Время
+// выполнения задачи в накладные расходы не входит.
+bool Scheduler::dispatch(const TaskTable &table) {
+  auto boundary = std::chrono::steady_clock::now();
+
+  // Отложенные обработчики прерываний и истёкшие ожидания делают задачи
+  // готовыми до выбора
+  interrupts.dispatchPending();
+  expireTimedWaits();
+
+  // Поиск готовой задачи с наивысшим приоритетом (без вытеснения)
+  int selectedId = selectTask(table);
+  Task *selectedTask = selectedId >= 0 ? table.byId[selectedId] : nullptr;
+
+  if (!selectedTask) {
+    publishSnapshot(table, -1);
+    return false;
+  }
+
+  RTOS_LOG(DEBUG, SCHEDULER, "Task ", selectedTask->getId(),
+           " selected for execution");
+  interrupts.onTaskDispatched(selectedTask);
+  publishSnapshot(table, selectedTask->getId());
+  auto begin = std::chrono::steady_clock::now();
+  selectedTask->execute();
+  auto end = std::chrono::steady_clock::now();
+  checkBudget(selectedTask, end - begin);
+  RTOS_LOG(DEBUG, SCHEDULER, "Task ", selectedTask->getId(),
+           " completed execution");
+
+  recordDispatchOverhead((begin - boundary) +
+                         (std::chrono::steady_clock::now() - end));
+  return true;
+}
+
+void Scheduler::expireTimedWaits() {
+  auto now = std::chrono::steady_clock::now();
+  nextWaitDeadline = std::chrono::steady_clock::time_point::max();
+  for (auto semaphore : semaphores)
+    nextWaitDeadline = std::min(nextWaitDeadline, semaphore->expireWaits(now));
+  for (auto event : events)
+    nextWaitDeadline = std::min(nextWaitDeadline, event->expireWaits(now));
+}
+
+void Scheduler::recordDispatchOverhead(
+    std::chrono::steady_clock::duration overhead) {
+  std::uint64_t ns = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(overhead).count());
+  // Писатель один, поэтому достаточно relaxed
+  dispatchCount.fetch_add(1, std::memory_order_relaxed);
+  dispatchOverheadNs.fetch_add(ns, std::memory_order_relaxed);
+  if (ns > maxDispatchOverheadNs.load(std::memory_order_relaxed)) {
+    maxDispatchOverheadNs.store(ns, std::memory_order_relaxed);
+  }
+}
+
+// Циклический исполнитель: все решения приняты при построении таблицы, на
+// границе кадра задачи запускаются по списку кадра независимо от флагов
+// готовности. Кадры отсчитываются от номинального времени, поэтому после
+// переполнения кадра расписание догоняет, а не сдвигается.
+void Scheduler::cyclicLoop() {
+  const auto frameLength = std::chrono::milliseconds(cyclicSchedule.frameSize);
+  auto frameStart = std::chrono::steady_clock::now();
+  size_t frame = 0;
+  DispatchThreadScope scope;
+
+  while (running) {
+    std::uint64_t epoch = tableEpoch.load();
+    std::shared_ptr<const TaskTable> table = std::atomic_load(&taskTable);
+    quiescentEpoch = epoch;
+
+    interrupts.dispatchPending();
+    expireTimedWaits();
+
+    auto previous = std::chrono::steady_clock::now();
+    for (int id : cyclicSchedule.frames[frame]) {
+      Task *task = table->byId[id];
+      RTOS_LOG(DEBUG, SCHEDULER, "Task ", id, " dispatched in frame ", frame);
+      publishSnapshot(*table, id);
+      auto begin = std::chrono::steady_clock::now();
+      recordDispatchOverhead(begin - previous);
+      task->execute();
+      previous = std::chrono::steady_clock::now();
+      RTOS_LOG(DEBUG, SCHEDULER, "Task ", id, " completed execution");
+    }
+    publishSnapshot(*table, -1);
+
+    auto frameEnd = frameStart + frameLength;
+    auto now = std::chrono::steady_clock::now();
+    if (now > frameEnd) {
+      frameOverruns++;
+      RTOS_LOG(WARNING, SCHEDULER, "Frame ", frame, " overran by ",
+               std::chrono::duration_cast<std::chrono::microseconds>(
+                   now - frameEnd)
+                   .count(),
+               " us");
     } else {
-      // Нет готовых задач
-      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      std::this_thread::sleep_until(frameEnd);
     }
+
+    frameStart = frameEnd;
+    frame = (frame + 1) % cyclicSchedule.frames.size();
   }
+
+  quiescentEpoch = ~0ull;
+}
+
+std::vector<CyclicTaskParameters> Scheduler::cyclicParameters() const {
+  std::vector<CyclicTaskParameters> parameters;
+  for (auto task : std::atomic_load(&taskTable)->tasks) {
+    CyclicTaskParameters entry;
+    entry.id = task->getId();
+    entry.period = task->getPeriod();
+    entry.wcet = task->getWcet();
+    for (auto predecessor : task->getPredecessors())
+      entry.predecessors.push_back(predecessor->getId());
+    parameters.push_back(entry);
+  }
+  return parameters;
+}
+
+bool Scheduler::setSchedulingMode(SchedulingMode mode) {
+  if (running) {
+    RTOS_LOG(ERROR, SCHEDULER,
+             "Scheduling mode cannot change while the scheduler runs");
+    return false;
+  }
+  schedulingMode = mode;
+  return true;
+}
+
+SchedulingMode Scheduler::getSchedulingMode() const { return schedulingMode; }
+
+bool Scheduler::buildCyclicSchedule() {
+  if (running) {
+    RTOS_LOG(ERROR, SCHEDULER,
+             "Cyclic schedule cannot change while the scheduler runs");
+    return false;
+  }
+  return RTOS::buildCyclicSchedule(cyclicParameters(), cyclicSchedule);
+}
+
+bool Scheduler::loadCyclicSchedule(const std::string &text) {
+  if (running) {
+    RTOS_LOG(ERROR, SCHEDULER,
+             "Cyclic schedule cannot change while the scheduler runs");
+    return false;
+  }
+
+  CyclicSchedule loaded;
+  if (!importCyclicSchedule(text, loaded) ||
+      !verifyCyclicSchedule(cyclicParameters(), loaded)) {
+    return false;
+  }
+  cyclicSchedule = loaded;
+  RTOS_LOG(INFO, SCHEDULER, "Cyclic schedule loaded: ", loaded.frames.size(),
+           " frames of ", loaded.frameSize, " ms");
+  return true;
+}
+
+std::string Scheduler::exportCyclicSchedule() const {
+  return RTOS::exportCyclicSchedule(cyclicSchedule);
+}
+
+const CyclicSchedule &Scheduler::getCyclicSchedule() const {
+  return cyclicSchedule;
+}
+
+int Scheduler::getFrameOverrunCount() const { return frameOverruns; }
+
+bool Scheduler::step() {
+  if (running) {
+    RTOS_LOG(ERROR, SCHEDULER, "Cannot step a running scheduler");
+    return false;
+  }
+
+  // Как и поток планировщика, шаг объявляет используемую эпоху: задача,
+  // удалённая во время своего тела, освобождается только после шага
+  std::shared_ptr<const TaskTable> table;
+  {
+    std::lock_guard<std::mutex> lock(tableMutex);
+    quiescentEpoch = tableEpoch.load();
+    table = std::atomic_load(&taskTable);
+    assignRmaPriorities(*table);
+  }
+  DispatchThreadScope scope;
+  bool dispatched = dispatch(*table);
+  quiescentEpoch = ~0ull;
+  return dispatched;
+}
+
+DispatchStats Scheduler::getDispatchStats() const {
+  DispatchStats stats;
+  stats.dispatches = dispatchCount.load(std::memory_order_relaxed);
+  stats.totalOverheadNs = dispatchOverheadNs.load(std::memory_order_relaxed);
+  stats.maxOverheadNs = maxDispatchOverheadNs.load(std::memory_order_relaxed);
+  return stats;
+}
+
+// В режиме HI задания LO отбрасываются (их готовность снимается, в том
+// числе у заданий, ставших готовыми уже в режиме HI) или выполняются в
+// фоне. Когда не готова ни одна задача, система простаивает и
+// возвращается в режим LO.
+int Scheduler::selectTask(const TaskTable &table) {
+  if (criticalityMode == Criticality::Low) {
+    return controlBlocks.selectReady(table.members);
+  }
+
+  std::uint32_t highTasks =
+      table.members & controlBlocks.highCriticalityMask.load();
+  std::uint32_t lowTasks = table.members & ~highTasks;
+  if (sheddingPolicy == SheddingPolicy::Drop) {
+    std::uint32_t dropped =
+        controlBlocks.readyMask.fetch_and(~lowTasks) & lowTasks;
+    for (int id = 0; dropped; ++id, dropped >>= 1) {
+      if (dropped & 1u) {
+        droppedJobs++;
+        RTOS_LOG(DEBUG, SCHEDULER, "Task ", id, " job dropped in HI mode");
+      }
+    }
+  }
+
+  int selectedId = controlBlocks.selectReady(highTasks);
+  if (selectedId < 0 && sheddingPolicy == SheddingPolicy::Degrade) {
+    selectedId = controlBlocks.selectReady(lowTasks);
+  }
+
+  if (selectedId < 0) {
+    switchMode(Criticality::Low);
+    RTOS_LOG(INFO, SCHEDULER, "Criticality mode switched to LO: ",
+             "no high-criticality work pending");
+    selectedId = controlBlocks.selectReady(table.members);
+  }
+  return selectedId;
+}
+
+// Контроль бюджетов на точке диспетчеризации: задача HI, превысившая бюджет
+// LO, переключает систему в режим HI до начала следующего задания
+void Scheduler::checkBudget(Task *task,
+                            std::chrono::steady_clock::duration elapsed) {
+  auto elapsedMs =
+      std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+  Criticality level = task->getCriticality();
+  int budget = task->getWcet(criticalityMode);
+
+  if (budget <= 0 || elapsed <= std::chrono::milliseconds(budget)) {
+    return;
+  }
+
+  const char *mode = criticalityMode == Criticality::Low ? "LO" : "HI";
+  if (level == Criticality::High && criticalityMode == Criticality::Low) {
+    switchMode(Criticality::High);
+    RTOS_LOG(INFO, SCHEDULER, "Criticality mode switched to HI: Task ",
+             task->getId(), " exceeded its ", mode, " budget of ", budget,
+             " ms (took ", elapsedMs, " ms)");
+  } else {
+    RTOS_LOG(WARNING, SCHEDULER, "Task ", task->getId(), " exceeded its ",
+             mode, " budget of ", budget, " ms (took ", elapsedMs, " ms)");
+  }
+}
+
+// Причину переключения записывает вызывающий: сообщение собирается из
+// частей только при включённом журнале
+void Scheduler::switchMode(Criticality mode) {
+  criticalityMode = mode;
+  modeSwitches++;
 }
 
 void Scheduler::stop() {
@@ -133,23 +667,93 @@ void Scheduler::stop() {
     return;
 
   running = false;
-  logger.logEvent("Scheduler stopping");
+  RTOS_LOG(INFO, SCHEDULER, "Scheduler stopping");
 
   if (schedulerThread.joinable()) {
     schedulerThread.join();
   }
 
-  logger.logEvent("Scheduler stopped");
+  publishSnapshot(*std::atomic_load(&taskTable), -1);
+  interrupts.report();
+  RTOS_LOG(INFO, SCHEDULER, "Scheduler stopped");
+}
+
+// Публикация выполняется потоком планировщика на точках диспетчеризации
+// либо при остановленном планировщике, поэтому писатель всегда один
+void Scheduler::publishSnapshot(const TaskTable &table, int runningTaskId) {
+  SchedulerSnapshot state = {};
+  state.version = ++snapshotVersion;
+  state.running = running;
+  state.highCriticalityMode = criticalityMode == Criticality::High;
+  state.runningTaskId = runningTaskId;
+
+  state.taskCount = static_cast<int>(table.tasks.size());
+  for (int i = 0; i < state.taskCount; ++i) {
+    Task *task = table.tasks[i];
+    state.tasks[i].id = task->getId();
+    state.tasks[i].period = task->getPeriod();
+    state.tasks[i].basePriority = task->getBasePriority();
+    state.tasks[i].priority = task->getPriority();
+    state.tasks[i].ready = task->isReady();
+  }
+
+  state.semaphoreCount = semaphores.size();
+  for (int i = 0; i < state.semaphoreCount; ++i) {
+    state.semaphores[i] = semaphores[i]->getState();
+  }
+
+  snapshot.write(state);
 }
 
-const std::vector<Task *> &Scheduler::getTasks() const { return tasks; }
+SchedulerSnapshot Scheduler::getSnapshot() const { return snapshot.read(); }
 
-const std::vector<Semaphore *> &Scheduler::getSemaphores() const {
-  return semaphores;
+std::vector<Task *> Scheduler::getTasks() const {
+  return std::atomic_load(&taskTable)->tasks;
 }
 
-const std::vector<Event *> &Scheduler::getEvents() const { return events; }
+const SemaphoreList &Scheduler::getSemaphores() const { return semaphores; }
+
+const EventList &Scheduler::getEvents() const { return events; }
+
+const std::vector<Channel *> &Scheduler::getChannels() const {
+  return channels;
+}
 
 bool Scheduler::isRunning() const { return running; }
 
+bool Scheduler::isDispatchThread() { return dispatchThread; }
+
+InterruptController &Scheduler::getInterrupts() { return interrupts; }
+
+DeadlockDetector &Scheduler::getDeadlockDetector() { return deadlocks; }
+
+WorkerPool &Scheduler::getWorkers() { return workers; }
+
+void Scheduler::parallelFor(const Task *task, std::size_t begin,
+                            std::size_t end, std::size_t grain,
+                            const WorkerPool::RangeBody &body) {
+  workers.run(task, begin, end, grain, body);
+}
+
+void Scheduler::setSheddingPolicy(SheddingPolicy policy) {
+  sheddingPolicy = policy;
+}
+
+Criticality Scheduler::getCriticalityMode() const { return criticalityMode; }
+
+int Scheduler::getModeSwitchCount() const { return modeSwitches; }
+
+int Scheduler::getDroppedJobCount() const { return droppedJobs; }
+
+// Анализ AMC-rtb для текущей таблицы задач в порядке RMA
+bool Scheduler::analyzeSchedulability(std::vector<ResponseTime> &result) const {
+  std::vector<TaskParameters> parameters;
+  for (auto task : std::atomic_load(&taskTable)->tasks) {
+    parameters.push_back({task->getPeriod(), task->getWcet(Criticality::Low),
+                          task->getWcet(Criticality::High),
+                          task->getCriticality()});
+  }
+  return analyzeAmcRtb(parameters, result);
+}
+
 } // namespace RTOS
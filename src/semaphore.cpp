@@ -1,117 +1,530 @@
 // semaphore.cpp
 #include "../include/semaphore.h"
+#include "../include/deadlock_detector.h"
+#include "../include/futex.h"
 #include "../include/scheduler.h"
 #include <algorithm>
+#include <climits>
 
 namespace RTOS {
 
-Semaphore::Semaphore(int initialCount)
-    : count(initialCount), owner(nullptr), originalOwnerPriority(-1),
-      logger(SystemLog::getInstance()) {}
+using Clock = std::chrono::steady_clock;
 
-bool Semaphore::acquire(Task *task) {
+Semaphore::Semaphore(int id, int initialCount,
+                     const SemaphoreList *siblings,
+                     DeadlockDetector *deadlocks)
+    : id(id), count(initialCount), sleepers(0), maxCount(initialCount),
+      inversions(0), siblings(siblings), deadlocks(deadlocks),
+      expiredWaits(0),
+      nextDeadline(Clock::time_point::max().time_since_epoch().count()) {
+  // Очереди не растут на пути захвата
+  holders.reserve(MAX_TASKS);
+  waitingTasks.reserve(MAX_TASKS);
+  wokenDeadlines.fill(Clock::time_point::max());
+}
+
+int Semaphore::getId() const { return id; }
+
+int Semaphore::getCount() const { return count.load(); }
+
+int Semaphore::getMaxCount() const { return maxCount; }
+
+int Semaphore::getInversionCount() const { return inversions.load(); }
+
+// Захват единиц ресурса; вызывается под mtx при count >= units
+bool Semaphore::take(Task *task, int units) {
+  count -= units;
+  expiredWaits &= ~(1u << task->getId());
+  wokenDeadlines[task->getId()] = Clock::time_point::max();
+  waitingTasks.erase(
+      std::remove_if(waitingTasks.begin(), waitingTasks.end(),
+                     [task](const Waiter &w) { return w.task == task; }),
+      waitingTasks.end());
+
+  auto holder =
+      std::find_if(holders.begin(), holders.end(),
+                   [task](const Holder &h) { return h.task == task; });
+  if (holder != holders.end()) {
+    holder->units += units;
+  } else {
+    holders.push_back({task, units});
+  }
+  if (deadlocks) {
+    deadlocks->onAcquired(task, this);
+  }
+
+  RTOS_LOG(DEBUG, SEMAPHORE, "Task ", task->getId(), " acquired ", units,
+           " unit(s) of semaphore ", id, " (", count.load(), " left)");
+  return true;
+}
+
+bool Semaphore::acquire(Task *task, int units) {
+  TaskCall call(task);
+  if (!call.isEntered()) {
+    RTOS_LOG(ERROR, SEMAPHORE, "Destroyed Task ", task->getId(),
+             " cannot acquire semaphore ", id);
+    return false;
+  }
   std::unique_lock<std::mutex> lock(mtx);
 
-  if (count > 0) {
+  if (units <= 0 || units > maxCount) {
+    RTOS_LOG(ERROR, SEMAPHORE,
+             "Invalid number of units requested from semaphore ", id);
+    return false;
+  }
+
+  if (isFirstEligible(task, units)) {
     // Ресурс доступен
-    count--;
-    owner = task;
-    originalOwnerPriority = task->getPriority();
-    logger.logEvent("Task " + std::to_string(task->getId()) +
-                    " acquired semaphore");
-    return true;
+    return take(task, units);
+  }
+
+  // Ресурс недоступен
+  enqueue(task, units, false, Clock::time_point::max());
+  return false;
+}
+
+// Постановка в очередь ожидания; вызывается под mtx. Ожидание, замыкающее
+// цикл в графе ожидания, отклоняется: задача остаётся готовой и не
+// ставится в очередь
+bool Semaphore::enqueue(Task *task, int units, bool sleeping,
+                        Clock::time_point deadline) {
+  if (deadlocks && !deadlocks->onWait(task, this)) {
+    return false;
+  }
+
+  expiredWaits &= ~(1u << task->getId());
+  auto waiter =
+      std::find_if(waitingTasks.begin(), waitingTasks.end(),
+                   [task](const Waiter &w) { return w.task == task; });
+  if (waiter != waitingTasks.end()) {
+    waiter->units = units;
+    waiter->sleeping = sleeping;
+    waiter->deadline = deadline;
   } else {
-    // Ресурс недоступен
-    waitingTasks.push_back(task);
-
-    // Реализация Priority Inheritance - исправленная версия
-    if (owner) {
-      int oldPriority = owner->getPriority();
-      if (task->getPriority() > owner->getPriority()) {
-        owner->setPriority(task->getPriority());
-        logger.logEvent("Task " + std::to_string(owner->getId()) +
-                        " inherited priority " +
-                        std::to_string(task->getPriority()) + " from Task " +
-                        std::to_string(task->getId()) + " (was " +
-                        std::to_string(oldPriority) + ")");
-      }
+    waitingTasks.push_back({task, units, sleeping, deadline});
+  }
+
+  if (!sleeping && deadline.time_since_epoch().count() < nextDeadline) {
+    nextDeadline = deadline.time_since_epoch().count();
+  }
+
+  // Priority Inheritance: приоритет наследуют все текущие держатели.
+  // Ожидание держателя с меньшим базовым приоритетом - инверсия приоритетов
+  bool inverted = false;
+  for (auto &holder : holders) {
+    Task *owner = holder.task;
+    inverted = inverted || owner->getBasePriority() < task->getPriority();
+    int oldPriority = owner->getPriority();
+    if (task->getPriority() > oldPriority) {
+      owner->setEffectivePriority(task->getPriority());
+      RTOS_LOG(INFO, SEMAPHORE, "Task ", owner->getId(),
+               " inherited priority ", task->getPriority(), " from Task ",
+               task->getId(), " (was ", oldPriority, ")");
     }
+  }
+
+  if (inverted) {
+    inversions++;
+  }
 
-    task->setReady(false);
-    logger.logEvent("Task " + std::to_string(task->getId()) +
-                    " waiting for semaphore");
+  task->setReady(false);
+  RTOS_LOG(DEBUG, SEMAPHORE, "Task ", task->getId(), " waiting for semaphore ",
+           id);
+  return true;
+}
+
+// Задача может забрать единицы, только если среди ожидающих нет задачи с
+// не меньшим приоритетом, которой хватает свободных единиц
+bool Semaphore::isFirstEligible(const Task *task, int units) const {
+  int available = count.load();
+  if (available < units) {
     return false;
   }
+
+  for (auto &waiter : waitingTasks) {
+    if (waiter.task == task) {
+      return true;
+    }
+    if (waiter.units <= available &&
+        waiter.task->getPriority() >= task->getPriority()) {
+      return false;
+    }
+  }
+  return true;
 }
 
-void Semaphore::release(Task *task) {
+std::vector<Task *> Semaphore::holdersExcept(const Task *task) const {
+  std::vector<Task *> result;
+  for (auto &holder : holders) {
+    if (holder.task != task) {
+      result.push_back(holder.task);
+    }
+  }
+  return result;
+}
+
+bool Semaphore::acquire(Task *task, std::chrono::milliseconds timeout,
+                        int units) {
+  auto deadline = Clock::now() + timeout;
+  TaskCall call(task);
+  if (!call.isEntered()) {
+    RTOS_LOG(ERROR, SEMAPHORE, "Destroyed Task ", task->getId(),
+             " cannot acquire semaphore ", id);
+    return false;
+  }
   std::unique_lock<std::mutex> lock(mtx);
 
-  if (owner == task) {
-    // Перед восстановлением приоритета нужно проверить другие семафоры
-    if (originalOwnerPriority != -1) {
-      // Проверяем, удерживает ли задача другие семафоры с наследованием
-      // приоритета
-      bool canRestorePriority = true;
-      int highestWaiterPriority = originalOwnerPriority;
-
-      // Получаем список всех семафоров из планировщика
-      auto &allSemaphores = Scheduler::getInstance().getSemaphores();
-
-      // Проверяем каждый семафор, который может удерживать эта задача
-      for (auto sem : allSemaphores) {
-        if (sem != this && sem->getOwner() == task) {
-          // Находим задачу с наивысшим приоритетом среди ожидающих этот семафор
-          for (auto &waiter : sem->getWaitingTasks()) {
-            if (waiter->getPriority() > highestWaiterPriority) {
-              highestWaiterPriority = waiter->getPriority();
-              canRestorePriority = false;
-            }
-          }
-        }
+  if (units <= 0 || units > maxCount) {
+    RTOS_LOG(ERROR, SEMAPHORE,
+             "Invalid number of units requested from semaphore ", id);
+    return false;
+  }
+
+  // Быстрый путь без системного вызова
+  if (isFirstEligible(task, units)) {
+    return take(task, units);
+  }
+
+  // Тело задачи выполняется потоком планировщика: сон на futex остановил
+  // бы ядро вместе с держателем ресурса. Задача перестаёт быть готовой до
+  // освобождения ресурса или срока и повторяет захват при следующем
+  // запуске; об истёкшем сроке сообщает этот повторный вызов. Если
+  // единицы, освобождённые для задачи, успела забрать другая задача,
+  // ожидание продолжается с исходным сроком.
+  if (Scheduler::isDispatchThread()) {
+    std::uint32_t bit = 1u << task->getId();
+    if (expiredWaits & bit) {
+      expiredWaits &= ~bit;
+      return false;
+    }
+    Clock::time_point &woken = wokenDeadlines[task->getId()];
+    if (woken != Clock::time_point::max()) {
+      deadline = woken;
+      woken = Clock::time_point::max();
+    } else if (timeout.count() <= 0) {
+      return false;
+    }
+    if (deadline <= Clock::now()) {
+      RTOS_LOG(DEBUG, SEMAPHORE, "Task ", task->getId(),
+               " timed out waiting for semaphore ", id);
+      return false;
+    }
+    enqueue(task, units, false, deadline);
+    return false;
+  }
+
+  if (timeout.count() <= 0 ||
+      !enqueue(task, units, true, Clock::time_point::max())) {
+    return false;
+  }
+
+  while (true) {
+    int observed = count.load();
+    sleepers++;
+    lock.unlock();
+
+    auto now = std::chrono::steady_clock::now();
+    if (now < deadline) {
+      futexWait(&count, observed, deadline - now);
+    }
+
+    lock.lock();
+    sleepers--;
+
+    bool acquired = isFirstEligible(task, units);
+    if (!acquired && std::chrono::steady_clock::now() < deadline) {
+      continue;
+    }
+
+    // Ожидание завершено: задача сама снимает себя с очереди, чтобы
+    // состояние PIP не ссылалось на неё после таймаута
+    task->setReady(true);
+
+    if (acquired) {
+      take(task, units);
+    } else {
+      waitingTasks.erase(
+          std::remove_if(waitingTasks.begin(), waitingTasks.end(),
+                         [task](const Waiter &w) { return w.task == task; }),
+          waitingTasks.end());
+      if (deadlocks) {
+        deadlocks->onWaitEnded(task);
       }
+      RTOS_LOG(DEBUG, SEMAPHORE, "Task ", task->getId(),
+               " timed out waiting for semaphore ", id);
+    }
+
+    std::vector<Task *> boostedHolders = holdersExcept(task);
+    lock.unlock();
+
+    for (auto holder : boostedHolders) {
+      updateInheritedPriority(holder);
+    }
+    return acquired;
+  }
+}
 
-      // Восстанавливаем приоритет только если нет других семафоров с ожидающими
-      // задачами высокого приоритета
-      if (canRestorePriority) {
-        logger.logEvent("Task " + std::to_string(task->getId()) +
-                        " restored to original priority " +
-                        std::to_string(originalOwnerPriority));
-        task->setPriority(originalOwnerPriority);
+bool Semaphore::tryAcquire(Task *task, int units) {
+  TaskCall call(task);
+  if (!call.isEntered()) {
+    RTOS_LOG(ERROR, SEMAPHORE, "Destroyed Task ", task->getId(),
+             " cannot acquire semaphore ", id);
+    return false;
+  }
+  std::unique_lock<std::mutex> lock(mtx);
+
+  if (units <= 0 || !isFirstEligible(task, units)) {
+    return false;
+  }
+
+  return take(task, units);
+}
+
+void Semaphore::release(Task *task, int units) {
+  std::vector<Task *> remainingHolders;
+  bool wakeSleepers = false;
+
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    auto holder =
+        std::find_if(holders.begin(), holders.end(),
+                     [task](const Holder &h) { return h.task == task; });
+    if (holder == holders.end() || units <= 0 || units > holder->units) {
+      RTOS_LOG(ERROR, SEMAPHORE, "Task ", task->getId(), " cannot release ",
+               units, " unit(s) of semaphore ", id);
+      return;
+    }
+
+    holder->units -= units;
+    if (holder->units == 0) {
+      holders.erase(holder);
+      if (deadlocks) {
+        deadlocks->onReleased(task, this);
+      }
+    }
+    count += units;
+
+    // Пробуждаем ожидающие задачи в порядке приоритета, пока хватает
+    // освободившихся единиц
+    std::stable_sort(waitingTasks.begin(), waitingTasks.end(),
+                     [](const Waiter &a, const Waiter &b) {
+                       return a.task->getPriority() > b.task->getPriority();
+                     });
+
+    // Единицы, достающиеся ожидающим на futex, резервируются за ними:
+    // такие задачи забирают их сами после пробуждения
+    int available = count.load();
+    for (auto it = waitingTasks.begin(); it != waitingTasks.end();) {
+      if (it->units > available) {
+        ++it;
+      } else if (it->sleeping) {
+        available -= it->units;
+        wakeSleepers = true;
+        ++it;
       } else {
-        logger.logEvent("Task " + std::to_string(task->getId()) +
-                        " maintains inherited priority " +
-                        std::to_string(highestWaiterPriority) +
-                        " due to other semaphores");
-        task->setPriority(highestWaiterPriority);
+        available -= it->units;
+        wokenDeadlines[it->task->getId()] = it->deadline;
+        it->task->setReady(true);
+        if (deadlocks) {
+          deadlocks->onWaitEnded(it->task);
+        }
+        RTOS_LOG(DEBUG, SEMAPHORE, "Task ", it->task->getId(),
+                 " woken up after semaphore release");
+        it = waitingTasks.erase(it);
+      }
+    }
+
+    RTOS_LOG(DEBUG, SEMAPHORE, "Task ", task->getId(), " released ", units,
+             " unit(s) of semaphore ", id);
+
+    remainingHolders = holdersExcept(task);
+    wakeSleepers = wakeSleepers && sleepers.load() > 0;
+  }
+
+  if (wakeSleepers) {
+    futexWake(&count, INT_MAX);
+  }
+
+  // Пробуждённые задачи больше не ожидают, поэтому наследованные приоритеты
+  // пересчитываются для освободившей задачи и остальных держателей
+  updateInheritedPriority(task);
+  for (auto other : remainingHolders) {
+    updateInheritedPriority(other);
+  }
+}
+
+// Снимает задачу с очереди ожидания без захвата ресурса
+void Semaphore::cancelWait(Task *task) {
+  std::vector<Task *> boostedHolders;
+
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    expiredWaits &= ~(1u << task->getId());
+    wokenDeadlines[task->getId()] = Clock::time_point::max();
+    auto waiter =
+        std::find_if(waitingTasks.begin(), waitingTasks.end(),
+                     [task](const Waiter &w) { return w.task == task; });
+    if (waiter == waitingTasks.end()) {
+      return;
+    }
+
+    waitingTasks.erase(waiter);
+    if (deadlocks) {
+      deadlocks->onWaitEnded(task);
+    }
+    boostedHolders = holdersExcept(task);
+  }
+
+  for (auto holder : boostedHolders) {
+    updateInheritedPriority(holder);
+  }
+}
+
+Clock::time_point Semaphore::expireWaits(Clock::time_point now) {
+  // Без ожиданий со сроком до now мьютекс не берётся
+  Clock::time_point next(Clock::duration(nextDeadline.load()));
+  if (now < next) {
+    return next;
+  }
+
+  std::vector<Task *> boostedHolders;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    next = Clock::time_point::max();
+    bool expired = false;
+    for (auto it = waitingTasks.begin(); it != waitingTasks.end();) {
+      if (it->sleeping || it->deadline > now) {
+        if (!it->sleeping) {
+          next = std::min(next, it->deadline);
+        }
+        ++it;
+        continue;
       }
 
-      originalOwnerPriority = -1;
+      // Задача снова готова; повторный захват сообщит ей о таймауте
+      Task *task = it->task;
+      expiredWaits |= 1u << task->getId();
+      task->setReady(true);
+      if (deadlocks) {
+        deadlocks->onWaitEnded(task);
+      }
+      RTOS_LOG(DEBUG, SEMAPHORE, "Task ", task->getId(),
+               " timed out waiting for semaphore ", id);
+      it = waitingTasks.erase(it);
+      expired = true;
+    }
+
+    nextDeadline = next.time_since_epoch().count();
+    if (expired) {
+      boostedHolders = holdersExcept(nullptr);
     }
+  }
 
-    owner = nullptr;
-    count++;
+  for (auto holder : boostedHolders) {
+    updateInheritedPriority(holder);
+  }
+  return next;
+}
 
-    // Поиск задачи с наивысшим приоритетом среди ожидающих
-    if (!waitingTasks.empty()) {
-      auto highestPriorityTask = *std::max_element(
-          waitingTasks.begin(), waitingTasks.end(),
-          [](Task *a, Task *b) { return a->getPriority() < b->getPriority(); });
+// Эффективный приоритет задачи - максимум из её базового приоритета и
+// приоритетов задач, ожидающих семафоры, которые она удерживает
+void Semaphore::updateInheritedPriority(Task *task) {
+  int highestWaiterPriority = task->getBasePriority();
 
-      waitingTasks.erase(std::remove(waitingTasks.begin(), waitingTasks.end(),
-                                     highestPriorityTask),
-                         waitingTasks.end());
+  auto consider = [&](const Semaphore *sem) {
+    if (sem->getHeldUnits(task) > 0) {
+      highestWaiterPriority =
+          std::max(highestWaiterPriority, sem->getHighestWaiterPriority());
+    }
+  };
 
-      highestPriorityTask->setReady(true);
-      logger.logEvent("Task " + std::to_string(highestPriorityTask->getId()) +
-                      " woken up after semaphore release");
+  consider(this);
+  for (auto sem : siblings ? *siblings
+                           : Scheduler::getInstance().getSemaphores()) {
+    if (sem != this) {
+      consider(sem);
     }
+  }
+
+  if (highestWaiterPriority == task->getPriority()) {
+    return;
+  }
+
+  if (highestWaiterPriority == task->getBasePriority()) {
+    RTOS_LOG(INFO, SEMAPHORE, "Task ", task->getId(),
+             " restored to original priority ", highestWaiterPriority);
+  } else {
+    RTOS_LOG(INFO, SEMAPHORE, "Task ", task->getId(),
+             " maintains inherited priority ", highestWaiterPriority,
+             " due to other semaphores");
+  }
+  task->setEffectivePriority(highestWaiterPriority);
+}
+
+std::vector<Task *> Semaphore::getWaitingTasks() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  std::vector<Task *> result;
+  for (auto &waiter : waitingTasks) {
+    result.push_back(waiter.task);
+  }
+  return result;
+}
+
+int Semaphore::getHighestWaiterPriority() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (waitingTasks.empty()) {
+    return -1;
+  }
+
+  // Ожидающие задачи одного планировщика: приоритеты сканируются по
+  // горячему массиву за один проход
+  std::uint32_t mask = 0;
+  for (auto &waiter : waitingTasks) {
+    mask |= 1u << waiter.task->getId();
+  }
+  return waitingTasks.front().task->getControlBlocks().highestPriority(mask);
+}
 
-    logger.logEvent("Task " + std::to_string(task->getId()) +
-                    " released semaphore");
+Task *Semaphore::getOwner() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  return holders.empty() ? nullptr : holders.front().task;
+}
+
+std::vector<Task *> Semaphore::getHolders() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  std::vector<Task *> result;
+  for (auto &holder : holders) {
+    result.push_back(holder.task);
   }
+  return result;
 }
 
-Task *Semaphore::getOwner() const { return owner; }
+int Semaphore::getHeldUnits(const Task *task) const {
+  std::lock_guard<std::mutex> lock(mtx);
+  for (auto &holder : holders) {
+    if (holder.task == task) {
+      return holder.units;
+    }
+  }
+  return 0;
+}
+
+SemaphoreState Semaphore::getState() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  SemaphoreState state;
+  state.id = id;
+  state.count = count.load();
+  state.maxCount = maxCount;
+  state.holders = 0;
+  state.waiters = 0;
+  for (auto &holder : holders) {
+    state.holders |= 1u << holder.task->getId();
+  }
+  for (auto &waiter : waitingTasks) {
+    state.waiters |= 1u << waiter.task->getId();
+  }
+  return state;
+}
 
 } // namespace RTOS
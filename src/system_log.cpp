@@ -3,6 +3,16 @@
 
 namespace RTOS {
 
+std::atomic<std::uint32_t> SystemLog::categoryMask(LOG_ALL);
+
+void SystemLog::setCategoryMask(std::uint32_t mask) {
+  categoryMask.store(mask, std::memory_order_relaxed);
+}
+
+std::uint32_t SystemLog::getCategoryMask() {
+  return categoryMask.load(std::memory_order_relaxed);
+}
+
 void SystemLog::logEvent(const std::string &eventDescription) {
   std::lock_guard<std::mutex> lock(logMutex);
   auto now = std::chrono::system_clock::now();
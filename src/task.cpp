@@ -1,24 +1,76 @@
 // task.cpp
 #include "../include/task.h"
 #include "../include/event.h"
+#include <algorithm>
 
 namespace RTOS {
 
-Task::Task(int id, int priority, int period, std::function<void()> func)
-    : id(id), priority(priority), period(period), ready(true),
-      taskFunction(func) {}
+Task::Task(TaskControlBlocks &controlBlocks, int id, int priority,
+           int period, std::function<void()> func)
+    : controlBlocks(controlBlocks), id(id), wcet{0, 0}, taskFunction(func),
+      kernelCalls(0) {
+  controlBlocks.reset(id, priority, period);
+}
 
 int Task::getId() const { return id; }
 
-int Task::getPriority() const { return priority; }
+const TaskControlBlocks &Task::getControlBlocks() const {
+  return controlBlocks;
+}
+
+int Task::getPriority() const { return controlBlocks.getPriority(id); }
+
+int Task::getBasePriority() const { return controlBlocks.getBasePriority(id); }
+
+void Task::setPriority(int newPriority) {
+  controlBlocks.setBasePriority(id, newPriority);
+  controlBlocks.setPriority(id, newPriority);
+}
+
+// Смена базового приоритета не отменяет действующее наследование
+void Task::setBasePriority(int newPriority) {
+  int oldPriority = getBasePriority();
+  int priority = getPriority();
+  controlBlocks.setBasePriority(id, newPriority);
+  if (priority == oldPriority || priority < newPriority) {
+    controlBlocks.setPriority(id, newPriority);
+  }
+}
+
+void Task::setEffectivePriority(int newPriority) {
+  controlBlocks.setPriority(id, newPriority);
+}
+
+int Task::getPeriod() const { return controlBlocks.period[id]; }
+
+Criticality Task::getCriticality() const {
+  return controlBlocks.isHighCriticality(id) ? Criticality::High
+                                             : Criticality::Low;
+}
+
+void Task::setCriticality(Criticality level) {
+  controlBlocks.setHighCriticality(id, level == Criticality::High);
+}
+
+// Бюджет уровня HI не меньше бюджета LO; для задачи без отдельного бюджета
+// HI используется бюджет LO
+int Task::getWcet(Criticality level) const {
+  int low = wcet[static_cast<int>(Criticality::Low)];
+  if (level == Criticality::Low) {
+    return low;
+  }
+  return std::max(low, wcet[static_cast<int>(Criticality::High)]);
+}
 
-void Task::setPriority(int newPriority) { priority = newPriority; }
+void Task::setWcet(int newWcet) { setWcet(Criticality::Low, newWcet); }
 
-int Task::getPeriod() const { return period; }
+void Task::setWcet(Criticality level, int budget) {
+  wcet[static_cast<int>(level)] = budget;
+}
 
-bool Task::isReady() const { return ready; }
+bool Task::isReady() const { return controlBlocks.isReady(id); }
 
-void Task::setReady(bool state) { ready = state; }
+void Task::setReady(bool state) { controlBlocks.setReady(id, state); }
 
 void Task::execute() {
   if (taskFunction) {
@@ -30,4 +82,40 @@ void Task::addEvent(Event *event) { ownedEvents.push_back(event); }
 
 std::vector<Event *> &Task::getEvents() { return ownedEvents; }
 
+void Task::addPredecessor(Task *task) {
+  if (task != this && std::find(predecessors.begin(), predecessors.end(),
+                                task) == predecessors.end()) {
+    predecessors.push_back(task);
+  }
+}
+
+void Task::removePredecessor(Task *task) {
+  predecessors.erase(
+      std::remove(predecessors.begin(), predecessors.end(), task),
+      predecessors.end());
+}
+
+const std::vector<Task *> &Task::getPredecessors() const {
+  return predecessors;
+}
+
+bool Task::beginKernelCall() {
+  int calls = kernelCalls.load();
+  while (calls >= 0) {
+    if (kernelCalls.compare_exchange_weak(calls, calls + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Task::endKernelCall() { kernelCalls--; }
+
+bool Task::retire() {
+  int idle = 0;
+  return kernelCalls.compare_exchange_strong(idle, -1);
+}
+
+void Task::restore() { kernelCalls.store(0); }
+
 } // namespace RTOS
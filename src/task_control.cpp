@@ -0,0 +1,136 @@
+// task_control.cpp
+#include "../include/task_control.h"
+
+namespace RTOS {
+
+namespace {
+
+int loadByte(const std::atomic<std::uint64_t> *words, int id) {
+  std::uint64_t word = words[id / 8].load(std::memory_order_relaxed);
+  return static_cast<int>((word >> (8 * (id % 8))) & 0xff);
+}
+
+void storeByte(std::atomic<std::uint64_t> *words, int id, int value) {
+  std::atomic<std::uint64_t> &word = words[id / 8];
+  int shift = 8 * (id % 8);
+  std::uint64_t mask = std::uint64_t(0xff) << shift;
+  std::uint64_t current = word.load(std::memory_order_relaxed);
+  std::uint64_t desired;
+  do {
+    desired = (current & ~mask) |
+              (static_cast<std::uint64_t>(value & 0xff) << shift);
+  } while (!word.compare_exchange_weak(current, desired,
+                                       std::memory_order_relaxed));
+}
+
+// Копия приоритетов в локальный массив: после этого сканирование идёт по
+// обычной памяти и векторизуется компилятором
+void unpack(const std::atomic<std::uint64_t> *words, std::uint8_t *bytes) {
+  for (int w = 0; w < TaskControlBlocks::PRIORITY_WORDS; ++w) {
+    std::uint64_t word = words[w].load(std::memory_order_relaxed);
+    for (int b = 0; b < 8; ++b) {
+      bytes[w * 8 + b] = static_cast<std::uint8_t>(word >> (8 * b));
+    }
+  }
+}
+
+// Ключ задачи: приоритет + 1 для задач маски, 0 для остальных
+std::uint8_t buildKeys(const std::atomic<std::uint64_t> *words,
+                       std::uint32_t mask, std::uint8_t *keys) {
+  std::uint8_t priorities[MAX_TASKS];
+  unpack(words, priorities);
+
+  std::uint8_t best = 0;
+  for (int i = 0; i < MAX_TASKS; ++i) {
+    std::uint8_t selected = static_cast<std::uint8_t>(0 - ((mask >> i) & 1u));
+    keys[i] = static_cast<std::uint8_t>((priorities[i] + 1) & selected);
+    best = keys[i] > best ? keys[i] : best;
+  }
+  return best;
+}
+
+} // namespace
+
+TaskControlBlocks::TaskControlBlocks()
+    : readyMask(0), highCriticalityMask(0) {
+  for (int w = 0; w < PRIORITY_WORDS; ++w) {
+    priority[w].store(0, std::memory_order_relaxed);
+    basePriority[w].store(0, std::memory_order_relaxed);
+  }
+  for (int i = 0; i < MAX_TASKS; ++i) {
+    period[i] = 0;
+  }
+}
+
+void TaskControlBlocks::reset(int id, int taskPriority, int taskPeriod) {
+  period[id] = taskPeriod;
+  setBasePriority(id, taskPriority);
+  setPriority(id, taskPriority);
+  setReady(id, true);
+  setHighCriticality(id, false);
+}
+
+int TaskControlBlocks::getPriority(int id) const {
+  return loadByte(priority, id);
+}
+
+void TaskControlBlocks::setPriority(int id, int value) {
+  storeByte(priority, id, value);
+}
+
+int TaskControlBlocks::getBasePriority(int id) const {
+  return loadByte(basePriority, id);
+}
+
+void TaskControlBlocks::setBasePriority(int id, int value) {
+  storeByte(basePriority, id, value);
+}
+
+bool TaskControlBlocks::isReady(int id) const {
+  return (readyMask.load() >> id) & 1u;
+}
+
+void TaskControlBlocks::setReady(int id, bool state) {
+  if (state) {
+    readyMask.fetch_or(1u << id);
+  } else {
+    readyMask.fetch_and(~(1u << id));
+  }
+}
+
+bool TaskControlBlocks::isHighCriticality(int id) const {
+  return (highCriticalityMask.load() >> id) & 1u;
+}
+
+void TaskControlBlocks::setHighCriticality(int id, bool state) {
+  if (state) {
+    highCriticalityMask.fetch_or(1u << id);
+  } else {
+    highCriticalityMask.fetch_and(~(1u << id));
+  }
+}
+
+int TaskControlBlocks::highestPriority(std::uint32_t mask) const {
+  std::uint8_t keys[MAX_TASKS];
+  return static_cast<int>(buildKeys(priority, mask, keys)) - 1;
+}
+
+int TaskControlBlocks::selectReady(std::uint32_t candidates) const {
+  std::uint32_t ready = readyMask.load() & candidates;
+  if (ready == 0) {
+    return -1;
+  }
+
+  std::uint8_t keys[MAX_TASKS];
+  std::uint8_t best = buildKeys(priority, ready, keys);
+
+  int selected = -1;
+  for (int i = 0; i < MAX_TASKS; ++i) {
+    if (keys[i] == best && (selected < 0 || period[i] < period[selected])) {
+      selected = i;
+    }
+  }
+  return selected;
+}
+
+} // namespace RTOS
@@ -0,0 +1,217 @@
+// worker_pool.cpp
+#include "../include/worker_pool.h"
+#include "../include/futex.h"
+#include "../include/system_log.h"
+#include <algorithm>
+#include <climits>
+#include <pthread.h>
+#include <sched.h>
+
+namespace RTOS {
+
+namespace {
+
+// Приоритет для раздачи кусков; задания без задачи - наименее важные
+int ownerPriority(const Task *owner) {
+  return owner ? owner->getPriority() : -1;
+}
+
+} // namespace
+
+int mapOsPriority(int policy, int threadPriority, int taskPriority) {
+  if (policy != SCHED_FIFO && policy != SCHED_RR) {
+    return threadPriority;
+  }
+  int mapped = sched_get_priority_min(policy) + std::max(0, taskPriority);
+  mapped = std::min(mapped, sched_get_priority_max(policy));
+  return std::max(threadPriority, mapped);
+}
+
+WorkerPool::WorkerPool()
+    : started(false), stopping(false), completions(0), waiting(0) {
+  int cores = static_cast<int>(std::thread::hardware_concurrency());
+  // Одно ядро занято самой вызывающей задачей
+  workerCount = std::min(MAX_PARALLEL_WORKERS, std::max(1, cores - 1));
+  for (int i = 0; i < MAX_PARALLEL_WORKERS; ++i)
+    workerPriority[i].store(-1);
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stopping = true;
+  }
+  workAvailable.notify_all();
+  for (auto &worker : workers)
+    worker.join();
+}
+
+bool WorkerPool::setWorkerCount(int count) {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (started) {
+    RTOS_LOG(ERROR, SCHEDULER,
+             "Worker count cannot change after the first parallel loop");
+    return false;
+  }
+  if (count < 0 || count > MAX_PARALLEL_WORKERS) {
+    RTOS_LOG(ERROR, SCHEDULER, "Worker count must be between 0 and ",
+             MAX_PARALLEL_WORKERS);
+    return false;
+  }
+  workerCount = count;
+  return true;
+}
+
+int WorkerPool::getWorkerCount() const { return workerCount; }
+
+int WorkerPool::getWorkerPriority(int worker) const {
+  if (worker < 0 || worker >= MAX_PARALLEL_WORKERS) {
+    return -1;
+  }
+  return workerPriority[worker].load();
+}
+
+// Вызывается под mtx
+void WorkerPool::startWorkers() {
+  started = true;
+  for (int i = 0; i < workerCount; ++i)
+    workers.emplace_back([this, i]() { workerLoop(i); });
+  RTOS_LOG(INFO, SCHEDULER, "Worker pool started with ", workerCount,
+           " helper threads");
+}
+
+// Выдача очередного куска; вызывается под mtx. Если only задан, кусок
+// берётся только из этого задания, иначе - из задания задачи с наибольшим
+// эффективным приоритетом на текущий момент.
+bool WorkerPool::take(Job *only, Job *&job, std::size_t &from,
+                      std::size_t &to) {
+  auto selected = jobs.end();
+  for (auto it = jobs.begin(); it != jobs.end(); ++it) {
+    if (only ? *it == only
+             : selected == jobs.end() ||
+                   ownerPriority((*it)->owner) >
+                       ownerPriority((*selected)->owner)) {
+      selected = it;
+    }
+  }
+  if (selected == jobs.end()) {
+    return false;
+  }
+
+  job = *selected;
+  from = job->next;
+  to = std::min(job->end, from + job->grain);
+  job->next = to;
+  if (to == job->end) {
+    jobs.erase(selected);
+  }
+  return true;
+}
+
+// Последний завершённый кусок будит вызывающую задачу. После уменьшения
+// счётчика задание может быть уже уничтожено, поэтому дальше используется
+// только общее слово пула.
+void WorkerPool::finish(Job *job) {
+  if (job->remaining.fetch_sub(1) == 1) {
+    completions.fetch_add(1);
+    if (waiting.load() > 0) {
+      futexWake(&completions, INT_MAX);
+    }
+  }
+}
+
+void WorkerPool::workerLoop(int index) {
+  int policy;
+  sched_param param;
+  pthread_getschedparam(pthread_self(), &policy, &param);
+
+  while (true) {
+    Job *job = nullptr;
+    std::size_t from = 0;
+    std::size_t to = 0;
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      workAvailable.wait(lock, [this]() { return stopping || !jobs.empty(); });
+      if (stopping) {
+        return;
+      }
+      take(nullptr, job, from, to);
+    }
+
+    // Поток ОС перенимает политику потока вызывающей задачи, а приоритет
+    // ОС пересчитывается из эффективного приоритета задачи перед каждым
+    // куском; без прав на повышение приоритета остаётся прежним
+    int priority = ownerPriority(job->owner);
+    int osPriority = mapOsPriority(job->policy, job->osPriority, priority);
+    if (job->policy != policy || osPriority != param.sched_priority) {
+      sched_param inherited = param;
+      inherited.sched_priority = osPriority;
+      if (pthread_setschedparam(pthread_self(), job->policy, &inherited) ==
+          0) {
+        policy = job->policy;
+        param = inherited;
+      }
+    }
+
+    workerPriority[index].store(priority);
+    (*job->body)(from, to);
+    workerPriority[index].store(-1);
+    finish(job);
+  }
+}
+
+void WorkerPool::run(const Task *owner, std::size_t begin, std::size_t end,
+                     std::size_t grain, const RangeBody &body) {
+  if (begin >= end) {
+    return;
+  }
+
+  Job job;
+  job.owner = owner;
+  job.body = &body;
+  job.next = begin;
+  job.end = end;
+  job.grain = std::max<std::size_t>(1, grain);
+  job.remaining = static_cast<int>((end - begin + job.grain - 1) / job.grain);
+
+  sched_param param;
+  pthread_getschedparam(pthread_self(), &job.policy, &param);
+  job.osPriority = param.sched_priority;
+
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!started) {
+      startWorkers();
+    }
+    jobs.push_back(&job);
+  }
+  workAvailable.notify_all();
+
+  // Вызывающая задача выполняет куски своего цикла сама
+  while (true) {
+    Job *claimed = nullptr;
+    std::size_t from = 0;
+    std::size_t to = 0;
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      if (!take(&job, claimed, from, to)) {
+        break;
+      }
+    }
+    body(from, to);
+    finish(&job);
+  }
+
+  // Ожидание кусков, ещё выполняемых вспомогательными потоками
+  while (true) {
+    int observed = completions.load();
+    if (job.remaining.load() == 0) {
+      break;
+    }
+    waiting++;
+    futexWait(&completions, observed, std::chrono::milliseconds(10));
+    waiting--;
+  }
+}
+
+} // namespace RTOS
@@ -10,6 +10,18 @@ void testNonpreemptiveScheduling();
 void testEvents();
 void testSemaphores();
 void testIntegration();
+void testCountingSemaphores();
+void testDeadlockDetection();
+void testTimedWaits();
+void testSnapshots();
+void testRuntimeTasks();
+void testTaskControlBlocks();
+void testInterrupts();
+void testMixedCriticality();
+void testLogging();
+void testChannels();
+void testCyclicExecutive();
+void testParallel();
 
 int main() {
   std::cout << "Запуск тестов RTOS..." << std::endl;
@@ -23,6 +35,42 @@ int main() {
   testNonpreemptiveScheduling();
   std::cout << "Тест планирования без вытеснения: ПРОЙДЕН" << std::endl;
 
+  testCountingSemaphores();
+  std::cout << "Тест считающих семафоров: ПРОЙДЕН" << std::endl;
+
+  testDeadlockDetection();
+  std::cout << "Тест обнаружения взаимоблокировок: ПРОЙДЕН" << std::endl;
+
+  testTimedWaits();
+  std::cout << "Тест ожидания с таймаутом: ПРОЙДЕН" << std::endl;
+
+  testSnapshots();
+  std::cout << "Тест срезов состояния планировщика: ПРОЙДЕН" << std::endl;
+
+  testRuntimeTasks();
+  std::cout << "Тест добавления и удаления задач: ПРОЙДЕН" << std::endl;
+
+  testTaskControlBlocks();
+  std::cout << "Тест горячих полей задач: ПРОЙДЕН" << std::endl;
+
+  testInterrupts();
+  std::cout << "Тест прерываний: ПРОЙДЕН" << std::endl;
+
+  testMixedCriticality();
+  std::cout << "Тест смешанной критичности: ПРОЙДЕН" << std::endl;
+
+  testLogging();
+  std::cout << "Тест уровней и категорий журнала: ПРОЙДЕН" << std::endl;
+
+  testChannels();
+  std::cout << "Тест межпроцессных каналов: ПРОЙДЕН" << std::endl;
+
+  testCyclicExecutive();
+  std::cout << "Тест циклического исполнителя: ПРОЙДЕН" << std::endl;
+
+  testParallel();
+  std::cout << "Тест параллельных циклов в задачах: ПРОЙДЕН" << std::endl;
+
   // testSemaphores();
   // testIntegration();
   // testEvents();
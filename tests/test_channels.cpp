@@ -0,0 +1,182 @@
+// test_channels.cpp
+#include "../include/rtos.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+void testChannels() {
+  RTOS::Scheduler scheduler;
+  RTOS::SystemLog &logger = RTOS::SystemLog::getInstance();
+  logger.clearLog();
+
+  std::string prefix = "/rtos_test_" + std::to_string(getpid()) + "_";
+
+  // Обмен с другим процессом: дочерний процесс подключается к каналам по
+  // имени и возвращает каждое сообщение, так что обе стороны засыпают на
+  // futex в разделяемой памяти. Процесс порождается до запуска потоков.
+  const int processTrips = 100;
+  auto request = scheduler.createChannel(prefix + "request", 64, 4);
+  auto response = scheduler.createChannel(prefix + "response", 64, 4);
+  assert(request && response);
+
+  pid_t child = fork();
+  assert(child >= 0);
+  if (child == 0) {
+    RTOS::Scheduler peer;
+    auto input = peer.openChannel(prefix + "request");
+    auto output = peer.openChannel(prefix + "response");
+    bool echoed = input && output;
+    for (int i = 0; echoed && i < processTrips; ++i) {
+      std::size_t size = 0;
+      const void *message = nullptr;
+      void *reply = nullptr;
+      echoed = input->waitForData(std::chrono::seconds(2)) &&
+               (message = input->beginReceive(size)) != nullptr &&
+               output->waitForSpace(std::chrono::seconds(2)) &&
+               (reply = output->beginSend()) != nullptr;
+      if (echoed) {
+        std::memcpy(reply, message, size);
+        echoed = output->endSend(size);
+        input->endReceive();
+      }
+    }
+    _exit(echoed ? 0 : 1);
+  }
+
+  for (int i = 0; i < processTrips; ++i) {
+    assert(request->send(&i, sizeof(i)));
+    assert(response->waitForData(std::chrono::seconds(2)));
+    std::size_t size = 0;
+    const void *message = response->beginReceive(size);
+    assert(message != nullptr && size == sizeof(int));
+    int value;
+    std::memcpy(&value, message, sizeof(value));
+    assert(value == i);
+    response->endReceive();
+  }
+  int status = 0;
+  assert(waitpid(child, &status, 0) == child);
+  assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  // Число слотов - степень двойки; имя занимается только один раз
+  assert(scheduler.createChannel(prefix + "bad", 16, 3) == nullptr);
+  auto sender = scheduler.createChannel(prefix + "data", 16, 4);
+  assert(sender != nullptr);
+  assert(scheduler.createChannel(prefix + "data", 16, 4) == nullptr);
+  assert(scheduler.openChannel(prefix + "missing") == nullptr);
+
+  // Второе отображение того же канала - как в другом процессе
+  auto receiver = scheduler.openChannel(prefix + "data");
+  assert(receiver != nullptr);
+  assert(receiver->getCapacity() == 4);
+  assert(receiver->getSlotSize() == 16);
+
+  // Сообщение длиннее слота не публикуется
+  assert(sender->beginSend() != nullptr);
+  assert(!sender->endSend(17));
+  assert(receiver->getPending() == 0);
+
+  // Сообщения пишутся и читаются прямо в слотах кольца
+  for (int i = 0; i < 4; ++i) {
+    void *slot = sender->beginSend();
+    assert(slot != nullptr);
+    std::memcpy(slot, &i, sizeof(i));
+    assert(sender->endSend(sizeof(i)));
+  }
+  assert(sender->beginSend() == nullptr);
+  assert(!sender->waitForSpace(std::chrono::milliseconds(1)));
+  assert(receiver->getPending() == 4);
+
+  for (int i = 0; i < 4; ++i) {
+    std::size_t length = 0;
+    const void *message = receiver->beginReceive(length);
+    assert(message != nullptr);
+    assert(length == sizeof(int));
+    int value;
+    std::memcpy(&value, message, sizeof(value));
+    assert(value == i);
+    receiver->endReceive();
+  }
+  std::size_t length = 0;
+  assert(receiver->beginReceive(length) == nullptr);
+  assert(!receiver->waitForData(std::chrono::milliseconds(1)));
+
+  // Приём делает задачу готовой через прерывание канала
+  const int messageCount = 200;
+  std::atomic<int> received(0);
+  std::atomic<int> sum(0);
+  RTOS::Task *consumer = nullptr;
+  consumer = scheduler.createTask(0, 100, [&]() {
+    std::size_t size = 0;
+    while (const void *message = receiver->beginReceive(size)) {
+      int value;
+      std::memcpy(&value, message, sizeof(value));
+      sum += value;
+      received++;
+      receiver->endReceive();
+    }
+    consumer->setReady(false);
+  });
+  consumer->setReady(false);
+  assert(receiver->bindReceiver(consumer));
+  assert(!receiver->bindReceiver(consumer));
+
+  scheduler.start();
+
+  std::thread producer([&]() {
+    for (int i = 1; i <= messageCount; ++i) {
+      while (!sender->send(&i, sizeof(i))) {
+        sender->waitForSpace(std::chrono::milliseconds(100));
+      }
+    }
+  });
+  producer.join();
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (received < messageCount &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  scheduler.stop();
+
+  assert(received == messageCount);
+  assert(sum == messageCount * (messageCount + 1) / 2);
+
+  // Обмен в обе стороны между потоками с ожиданием на futex
+  auto ping = scheduler.createChannel(prefix + "ping", 64, 8);
+  auto pingPeer = scheduler.openChannel(prefix + "ping");
+  auto pong = scheduler.createChannel(prefix + "pong", 64, 8);
+  auto pongPeer = scheduler.openChannel(prefix + "pong");
+  assert(ping && pingPeer && pong && pongPeer);
+
+  const int roundTrips = 1000;
+  std::thread echo([&]() {
+    for (int i = 0; i < roundTrips; ++i) {
+      assert(pingPeer->waitForData(std::chrono::seconds(1)));
+      std::size_t size = 0;
+      const void *message = pingPeer->beginReceive(size);
+      void *reply = pongPeer->beginSend();
+      assert(message && reply);
+      std::memcpy(reply, message, size);
+      assert(pongPeer->endSend(size));
+      pingPeer->endReceive();
+    }
+  });
+
+  for (int i = 0; i < roundTrips; ++i) {
+    assert(ping->send(&i, sizeof(i)));
+    assert(pong->waitForData(std::chrono::seconds(1)));
+    std::size_t size = 0;
+    const void *message = pong->beginReceive(size);
+    int value;
+    std::memcpy(&value, message, sizeof(value));
+    assert(size == sizeof(int) && value == i);
+    pong->endReceive();
+  }
+  echo.join();
+}
@@ -0,0 +1,69 @@
+// test_counting_semaphores.cpp
+#include "../include/rtos.h"
+#include <cassert>
+
+void testCountingSemaphores() {
+  RTOS::Scheduler scheduler;
+  RTOS::SystemLog &logger = RTOS::SystemLog::getInstance();
+  logger.clearLog();
+
+  assert(scheduler.createSemaphore(0) == nullptr);
+
+  // Пул из трёх одинаковых ресурсов (например, каналов DMA)
+  auto pool = scheduler.createSemaphore(3);
+  assert(pool != nullptr);
+  assert(pool->getCount() == 3);
+
+  auto lowTask = scheduler.createTask(2, 300, []() {});
+  auto midTask = scheduler.createTask(3, 200, []() {});
+  auto highTask = scheduler.createTask(9, 100, []() {});
+
+  // Два держателя одновременно
+  assert(pool->acquire(lowTask, 2));
+  assert(pool->tryAcquire(midTask));
+  assert(pool->getCount() == 0);
+  assert(pool->getHolders().size() == 2);
+  assert(pool->getHeldUnits(lowTask) == 2);
+  assert(pool->getHeldUnits(midTask) == 1);
+
+  // Неблокирующий захват не ставит задачу в очередь
+  assert(!pool->tryAcquire(highTask));
+  assert(highTask->isReady());
+  assert(pool->getWaitingTasks().empty());
+
+  // Запрос больше ёмкости пула отклоняется
+  assert(!pool->acquire(highTask, 4));
+  assert(highTask->isReady());
+
+  // Блокировка: приоритет наследуют оба держателя
+  assert(!pool->acquire(highTask, 2));
+  assert(!highTask->isReady());
+  assert(lowTask->getPriority() == 9);
+  assert(midTask->getPriority() == 9);
+
+  // Одной освобождённой единицы недостаточно для ожидающей задачи
+  pool->release(midTask);
+  assert(pool->getCount() == 1);
+  assert(!highTask->isReady());
+  assert(midTask->getPriority() == 3);
+  assert(lowTask->getPriority() == 9);
+
+  // Частичное освобождение будит ожидающую задачу
+  pool->release(lowTask, 1);
+  assert(pool->getCount() == 2);
+  assert(highTask->isReady());
+  assert(lowTask->getPriority() == 2);
+  assert(pool->getHeldUnits(lowTask) == 1);
+
+  assert(pool->acquire(highTask, 2));
+  assert(pool->getHeldUnits(highTask) == 2);
+
+  // Освобождение чужих единиц игнорируется
+  pool->release(midTask);
+  assert(pool->getCount() == 0);
+
+  pool->release(highTask, 2);
+  pool->release(lowTask);
+  assert(pool->getCount() == 3);
+  assert(pool->getHolders().empty());
+}
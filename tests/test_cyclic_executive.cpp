@@ -0,0 +1,138 @@
+// test_cyclic_executive.cpp
+#include "../include/rtos.h"
+#include <cassert>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Построение, проверка, экспорт и загрузка таблицы без планировщика
+static void testScheduleTable() {
+  std::vector<RTOS::CyclicTaskParameters> tasks = {
+      {0, 20, 5, {}}, {1, 40, 10, {}}, {2, 40, 10, {1}}};
+
+  RTOS::CyclicSchedule schedule;
+  assert(RTOS::buildCyclicSchedule(tasks, schedule));
+  assert(schedule.hyperperiod == 40);
+  // Кадр 40 мс нарушает условие 2f - gcd(p, f) <= p для периода 20
+  assert(schedule.frameSize == 20);
+  assert(schedule.frames.size() == 2);
+  assert(RTOS::verifyCyclicSchedule(tasks, schedule));
+
+  // Задача 2 запускается после своего предшественника
+  bool seenPredecessor = false;
+  for (auto &frame : schedule.frames) {
+    for (int id : frame) {
+      seenPredecessor = seenPredecessor || id == 1;
+      assert(id != 2 || seenPredecessor);
+    }
+  }
+
+  RTOS::CyclicSchedule loaded;
+  assert(RTOS::importCyclicSchedule(RTOS::exportCyclicSchedule(schedule),
+                                    loaded));
+  assert(loaded.hyperperiod == schedule.hyperperiod);
+  assert(loaded.frameSize == schedule.frameSize);
+  assert(loaded.frames == schedule.frames);
+
+  // Испорченные таблицы отклоняются
+  RTOS::CyclicSchedule broken = schedule;
+  broken.frames[0] = {0, 2, 1};
+  broken.frames[1] = {0};
+  assert(!RTOS::verifyCyclicSchedule(tasks, broken));
+  broken = schedule;
+  broken.frames[1].push_back(0);
+  assert(!RTOS::verifyCyclicSchedule(tasks, broken));
+  assert(!RTOS::importCyclicSchedule("hyperperiod 40\nframe_size 20\n1: 0\n",
+                                     loaded));
+
+  // Циклическое предшествование и слишком тяжёлый набор
+  std::vector<RTOS::CyclicTaskParameters> cyclic = {{0, 20, 5, {1}},
+                                                    {1, 20, 5, {0}}};
+  assert(!RTOS::buildCyclicSchedule(cyclic, schedule));
+  std::vector<RTOS::CyclicTaskParameters> overloaded = {{0, 20, 15, {}},
+                                                        {1, 20, 10, {}}};
+  assert(!RTOS::buildCyclicSchedule(overloaded, schedule));
+}
+
+void testCyclicExecutive() {
+  testScheduleTable();
+
+  RTOS::SystemLog &logger = RTOS::SystemLog::getInstance();
+  logger.clearLog();
+
+  std::mutex orderMutex;
+  std::vector<int> order;
+  auto record = [&](int id) {
+    std::lock_guard<std::mutex> lock(orderMutex);
+    order.push_back(id);
+  };
+
+  {
+    RTOS::Scheduler scheduler;
+    auto fast = scheduler.createTask(0, 20, [&]() { record(0); }, 2);
+    auto first = scheduler.createTask(0, 40, [&]() { record(1); }, 2);
+    auto second = scheduler.createTask(0, 40, [&]() { record(2); }, 2);
+    second->addPredecessor(first);
+    // Флаги готовности в циклическом режиме не учитываются
+    fast->setReady(false);
+
+    assert(scheduler.setSchedulingMode(RTOS::SchedulingMode::Cyclic));
+    assert(scheduler.buildCyclicSchedule());
+    std::string table = scheduler.exportCyclicSchedule();
+    assert(scheduler.loadCyclicSchedule(table));
+
+    scheduler.start();
+    assert(scheduler.isRunning());
+    assert(scheduler.createTask(0, 40, []() {}, 1) == nullptr);
+    assert(!scheduler.setSchedulingMode(RTOS::SchedulingMode::Priority));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    scheduler.stop();
+
+    // За 200 мс - около пяти гиперпериодов по 40 мс
+    std::lock_guard<std::mutex> lock(orderMutex);
+    int counts[3] = {0, 0, 0};
+    for (int id : order) {
+      counts[id]++;
+      if (id == 2) {
+        assert(counts[1] == counts[2]);
+      }
+    }
+    assert(counts[0] >= 8 && counts[0] <= 12);
+    assert(counts[1] >= 4 && counts[1] <= 6);
+    assert(counts[2] >= counts[1] - 1 && counts[2] <= counts[1]);
+    assert(scheduler.getFrameOverrunCount() == 0);
+  }
+
+  // Задача без WCET не допускает построения таблицы
+  {
+    RTOS::Scheduler scheduler;
+    scheduler.createTask(0, 20, []() {});
+    assert(scheduler.setSchedulingMode(RTOS::SchedulingMode::Cyclic));
+    scheduler.start();
+    assert(!scheduler.isRunning());
+  }
+
+  // Задача, превысившая заявленный WCET, переполняет кадр
+  {
+    RTOS::Scheduler scheduler;
+    scheduler.createTask(
+        0, 20,
+        []() { std::this_thread::sleep_for(std::chrono::milliseconds(30)); },
+        5);
+    assert(scheduler.setSchedulingMode(RTOS::SchedulingMode::Cyclic));
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    scheduler.stop();
+    assert(scheduler.getFrameOverrunCount() > 0);
+
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_WARNING
+    bool overrunLogged = false;
+    for (const auto &log : logger.getLog()) {
+      overrunLogged =
+          overrunLogged || log.find("overran by") != std::string::npos;
+    }
+    assert(overrunLogged);
+#endif
+  }
+}
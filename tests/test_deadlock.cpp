@@ -0,0 +1,70 @@
+// test_deadlock.cpp
+#include "../include/rtos.h"
+#include <cassert>
+
+void testDeadlockDetection() {
+  RTOS::Scheduler scheduler;
+  RTOS::SystemLog &logger = RTOS::SystemLog::getInstance();
+  RTOS::DeadlockDetector &detector = scheduler.getDeadlockDetector();
+  logger.clearLog();
+  detector.setEnabled(true);
+
+  auto semaphore1 = scheduler.createSemaphore();
+  auto semaphore2 = scheduler.createSemaphore();
+  auto pool = scheduler.createSemaphore(2);
+
+  auto task2 = scheduler.createTask(0, 100, []() {});
+  auto task4 = scheduler.createTask(0, 50, []() {});
+  auto task5 = scheduler.createTask(0, 200, []() {});
+
+  int detectedBefore = detector.getDetectedCount();
+
+  // Вложенный захват в противоположном порядке, как в test_integration
+  assert(semaphore2->acquire(task2));
+  assert(semaphore1->acquire(task4));
+  assert(!semaphore1->acquire(task2));
+  assert(!task2->isReady());
+
+  // Замыкание цикла отклоняется, задача не блокируется
+  assert(!semaphore2->acquire(task4));
+  assert(task4->isReady());
+  assert(semaphore2->getWaitingTasks().empty());
+  assert(detector.getDetectedCount() == detectedBefore + 1);
+
+  auto cycle = detector.getLastCycle();
+  assert(cycle.size() == 2);
+  assert(cycle[0].taskId == task4->getId());
+  assert(cycle[0].semaphoreId == semaphore2->getId());
+  assert(cycle[1].taskId == task2->getId());
+  assert(cycle[1].semaphoreId == semaphore1->getId());
+
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_ERROR
+  bool deadlockLogged = false;
+  for (const auto &log : logger.getLog()) {
+    if (log.find("Deadlock detected") != std::string::npos) {
+      deadlockLogged = true;
+      break;
+    }
+  }
+  assert(deadlockLogged);
+#endif
+
+  // После разрыва цикла ожидание снова разрешено
+  semaphore1->release(task4);
+  assert(task2->isReady());
+  assert(semaphore1->acquire(task2));
+  semaphore1->release(task2);
+  semaphore2->release(task2);
+
+  // Считающий семафор: пока хотя бы один держатель не заблокирован,
+  // взаимоблокировки нет
+  assert(pool->acquire(task2));
+  assert(pool->acquire(task5));
+  assert(semaphore1->acquire(task4));
+  assert(!semaphore1->acquire(task2));
+  assert(!pool->acquire(task4));
+  assert(!task4->isReady());
+  assert(detector.getDetectedCount() == detectedBefore + 1);
+
+  detector.setEnabled(false);
+}
@@ -0,0 +1,120 @@
+// test_interrupts.cpp
+#include "../include/rtos.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+namespace {
+RTOS::InterruptController *signalController = nullptr;
+int signalIrq = -1;
+
+void onSignal(int) { signalController->raise(signalIrq); }
+} // namespace
+
+void testInterrupts() {
+  RTOS::Scheduler scheduler;
+  RTOS::SystemLog &logger = RTOS::SystemLog::getInstance();
+  logger.clearLog();
+
+  RTOS::InterruptController &interrupts = scheduler.getInterrupts();
+
+  std::atomic<int> handlerRuns(0);
+  std::atomic<int> taskRuns(0);
+  std::atomic<int> deferredRuns(0);
+
+  // Задача обработки ввода-вывода ждёт прерывания
+  RTOS::Task *ioTask = nullptr;
+  ioTask = scheduler.createTask(0, 100, [&]() {
+    taskRuns++;
+    ioTask->setReady(false);
+  });
+  ioTask->setReady(false);
+
+  int ioIrq = interrupts.registerSource([&]() { handlerRuns++; }, ioTask);
+  int timerIrq = interrupts.registerSource([&]() { deferredRuns++; });
+  assert(ioIrq >= 0);
+  assert(timerIrq >= 0 && timerIrq != ioIrq);
+
+  // Неизвестные источники игнорируются
+  interrupts.raise(-1);
+  interrupts.raise(RTOS::MAX_INTERRUPTS - 1);
+
+  scheduler.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  assert(taskRuns == 0);
+
+  // Прерывание из другого потока
+  std::thread device([&]() { interrupts.raise(ioIrq); });
+  device.join();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  assert(handlerRuns == 1);
+  assert(taskRuns == 1);
+
+  // Прерывание из обработчика сигнала
+  signalController = &interrupts;
+  signalIrq = timerIrq;
+  auto previous = std::signal(SIGUSR1, onSignal);
+  std::raise(SIGUSR1);
+  std::signal(SIGUSR1, previous);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  assert(deferredRuns == 1);
+
+  scheduler.stop();
+
+  RTOS::InterruptStats ioStats = interrupts.getStats(ioIrq);
+  assert(ioStats.raised == 1);
+  assert(ioStats.serviced == 1);
+  assert(ioStats.measured == 1);
+  assert(ioStats.maxLatencyNs > 0);
+  assert(ioStats.totalLatencyNs == ioStats.maxLatencyNs);
+
+  RTOS::InterruptStats timerStats = interrupts.getStats(timerIrq);
+  assert(timerStats.serviced == 1);
+  assert(timerStats.measured == 1);
+
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_INFO
+  bool reported = false;
+  for (const auto &log : logger.getLog()) {
+    if (log.find("Interrupt " + std::to_string(ioIrq) + ": raised 1") !=
+        std::string::npos) {
+      reported = true;
+      break;
+    }
+  }
+  assert(reported);
+#endif
+
+  // Источник удалённой задачи больше не обращается к ней, а слот задержки
+  // не достаётся задаче с тем же id
+  RTOS::Task *blocker = nullptr;
+  blocker = scheduler.createTask(0, 10, [&]() { blocker->setReady(false); });
+  auto target = scheduler.createTask(0, 50, []() {});
+  target->setReady(false);
+  int targetIrq =
+      interrupts.registerSource(std::function<void()>(), target);
+  interrupts.raise(targetIrq);
+  assert(scheduler.step());
+  assert(target->isReady());
+
+  int targetId = target->getId();
+  assert(scheduler.destroyTask(target));
+  interrupts.raise(targetIrq);
+  assert(!scheduler.step());
+  assert(interrupts.getStats(targetIrq).serviced == 2);
+
+  auto successor = scheduler.createTask(0, 50, []() {});
+  assert(successor->getId() == targetId);
+  assert(scheduler.step());
+  assert(interrupts.getStats(targetIrq).measured == 1);
+
+  // Снятый источник игнорирует raise; номер освобождается на следующей
+  // обработке прерываний
+  assert(interrupts.unregisterSource(targetIrq));
+  assert(!interrupts.unregisterSource(targetIrq));
+  interrupts.raise(targetIrq);
+  assert(interrupts.getStats(targetIrq).raised == 2);
+  assert(scheduler.step());
+  assert(interrupts.registerSource([]() {}) == targetIrq);
+}
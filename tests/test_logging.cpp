@@ -0,0 +1,67 @@
+// test_logging.cpp
+#include "../include/rtos.h"
+#include <cassert>
+#include <string>
+
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_ERROR
+static bool contains(const std::string &needle) {
+  for (const auto &log : RTOS::SystemLog::getInstance().getLog()) {
+    if (log.find(needle) != std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+#endif
+
+void testLogging() {
+  RTOS::Scheduler scheduler;
+  RTOS::SystemLog &logger = RTOS::SystemLog::getInstance();
+  logger.clearLog();
+
+  auto semaphore = scheduler.createSemaphore();
+  auto task = scheduler.createTask(0, 100, []() {});
+
+  // Записи форматируются из частей; уровень ошибки добавляет префикс
+  RTOS_LOG(ERROR, SCHEDULER, "Value ", 42, " of ", std::string("test"));
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_ERROR
+  assert(contains("ERROR: Value 42 of test"));
+#else
+  assert(logger.getLog().empty());
+#endif
+
+  // Отключённая категория не пишет записи и не вычисляет аргументы
+  int evaluated = 0;
+  auto argument = [&]() {
+    evaluated++;
+    return 1;
+  };
+
+  std::uint32_t mask = RTOS::SystemLog::getCategoryMask();
+  RTOS::SystemLog::setCategoryMask(mask & ~RTOS::LOG_SEMAPHORE);
+  logger.clearLog();
+
+  RTOS_LOG(DEBUG, SEMAPHORE, "Masked ", argument());
+  assert(semaphore->acquire(task));
+  semaphore->release(task);
+  assert(evaluated == 0);
+  assert(logger.getLog().empty());
+
+  // Прочие категории продолжают писать
+  RTOS_LOG(INFO, SCHEDULER, "Unmasked ", argument());
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_INFO
+  assert(evaluated == 1);
+  assert(contains("Unmasked 1"));
+#else
+  // Уровень, удалённый при компиляции, тоже не вычисляет аргументы
+  assert(evaluated == 0);
+#endif
+
+  RTOS::SystemLog::setCategoryMask(mask);
+  logger.clearLog();
+  assert(semaphore->acquire(task));
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_DEBUG
+  assert(contains("acquired 1 unit(s) of semaphore"));
+#endif
+  semaphore->release(task);
+}
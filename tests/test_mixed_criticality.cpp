@@ -0,0 +1,123 @@
+// test_mixed_criticality.cpp
+#include "../include/rtos.h"
+#include <cassert>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+static void testAmcAnalysis() {
+  using RTOS::Criticality;
+
+  // Задачи в порядке убывания приоритета
+  std::vector<RTOS::TaskParameters> tasks = {
+      {10, 2, 4, Criticality::High},
+      {20, 5, 5, Criticality::Low},
+      {40, 5, 6, Criticality::High},
+  };
+
+  std::vector<RTOS::ResponseTime> result;
+  assert(RTOS::analyzeAmcRtb(tasks, result));
+  assert(result.size() == 3);
+
+  assert(result[0].lowMode == 7);
+  assert(result[1].lowMode == 12);
+  assert(result[2].lowMode == 12);
+
+  assert(result[0].highMode == 10);
+  assert(result[1].highMode == -1);
+  assert(result[2].highMode == 15);
+
+  // Рост бюджета HI нарушает срок только в режиме HI
+  tasks[0].wcetHigh = 5;
+  assert(!RTOS::analyzeAmcRtb(tasks, result));
+  assert(result[0].lowMode == 7);
+  assert(result[0].highMode == -1);
+  assert(!result[0].schedulable);
+  assert(result[2].schedulable);
+}
+
+void testMixedCriticality() {
+  testAmcAnalysis();
+
+  RTOS::Scheduler scheduler;
+  RTOS::SystemLog &logger = RTOS::SystemLog::getInstance();
+  logger.clearLog();
+
+  std::mutex orderMutex;
+  std::string order;
+
+  RTOS::Task *lowTask = nullptr;
+  RTOS::Task *highTask = nullptr;
+  int highRuns = 0;
+
+  // Задача LO с меньшим периодом имеет более высокий приоритет RMA
+  lowTask = scheduler.createTask(0, 50, [&]() {
+    {
+      std::lock_guard<std::mutex> lock(orderMutex);
+      order += 'L';
+    }
+    lowTask->setReady(false);
+  });
+  lowTask->setReady(false);
+
+  // Задача HI превышает бюджет LO в первом задании
+  highTask = scheduler.createTask(0, 100, [&]() {
+    {
+      std::lock_guard<std::mutex> lock(orderMutex);
+      order += 'H';
+    }
+    if (++highRuns == 1) {
+      lowTask->setReady(true);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (highRuns == 3) {
+      highTask->setReady(false);
+    }
+  });
+  highTask->setCriticality(RTOS::Criticality::High);
+  highTask->setWcet(RTOS::Criticality::Low, 2);
+  highTask->setWcet(RTOS::Criticality::High, 20);
+  assert(highTask->getWcet(RTOS::Criticality::High) == 20);
+  assert(lowTask->getWcet(RTOS::Criticality::High) == 0);
+
+  std::vector<RTOS::ResponseTime> result;
+  scheduler.start();
+  assert(scheduler.analyzeSchedulability(result));
+  assert(result.size() == 2);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+  // В режиме HI задание LO, ставшее готовым, отбрасывается; после простоя
+  // система возвращается в режим LO
+  {
+    std::lock_guard<std::mutex> lock(orderMutex);
+    assert(order == "HHH");
+  }
+  assert(!lowTask->isReady());
+  assert(scheduler.getDroppedJobCount() == 1);
+  assert(scheduler.getModeSwitchCount() == 2);
+  assert(scheduler.getCriticalityMode() == RTOS::Criticality::Low);
+
+  // Следующее задание LO выполняется в режиме LO
+  lowTask->setReady(true);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  scheduler.stop();
+  assert(order == "HHHL");
+  assert(scheduler.getDroppedJobCount() == 1);
+
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_INFO
+  bool switchedToHigh = false;
+  bool switchedToLow = false;
+  for (const auto &log : logger.getLog()) {
+    if (log.find("Criticality mode switched to HI") != std::string::npos) {
+      switchedToHigh = true;
+    }
+    if (log.find("Criticality mode switched to LO") != std::string::npos) {
+      switchedToLow = true;
+    }
+  }
+  assert(switchedToHigh);
+  assert(switchedToLow);
+#endif
+}
@@ -0,0 +1,134 @@
+// test_parallel.cpp
+#include "../include/rtos.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+#include <vector>
+
+void testParallel() {
+  RTOS::Scheduler scheduler;
+  assert(!scheduler.getWorkers().setWorkerCount(RTOS::MAX_PARALLEL_WORKERS +
+                                                1));
+  assert(scheduler.getWorkers().setWorkerCount(2));
+
+  const std::size_t count = 64;
+  std::vector<int> squares(count, 0);
+  long long sum = 0;
+  std::thread::id caller;
+  std::atomic<int> helperChunks(0);
+  std::atomic<bool> wrongPriority(false);
+  std::atomic<bool> notRunning(false);
+  RTOS::Task *low = nullptr;
+
+  // Приоритеты совпадают с RMA, поэтому step() их не меняет
+  auto high = scheduler.createTask(15, 100, []() {});
+  low = scheduler.createTask(14, 300, [&]() {
+    caller = std::this_thread::get_id();
+    scheduler.parallelFor(low, 0, count, 4, [&](std::size_t from,
+                                                std::size_t to) {
+      for (std::size_t i = from; i < to; ++i)
+        squares[i] = static_cast<int>(i * i);
+
+      // Пока выполняются куски, задача остаётся выполняемой
+      if (scheduler.getSnapshot().runningTaskId != low->getId()) {
+        notRunning = true;
+      }
+      if (std::this_thread::get_id() != caller) {
+        helperChunks++;
+        bool found = false;
+        for (int w = 0; w < 2; ++w) {
+          int priority = scheduler.getWorkers().getWorkerPriority(w);
+          found = found || priority == 15;
+          if (priority != -1 && priority != 15) {
+            wrongPriority = true;
+          }
+        }
+        if (!found) {
+          wrongPriority = true;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+
+    sum = scheduler.parallelReduce(
+        low, 0, count, 5, 0LL,
+        [](std::size_t from, std::size_t to) {
+          long long partial = 0;
+          for (std::size_t i = from; i < to; ++i)
+            partial += static_cast<long long>(i);
+          return partial;
+        },
+        [](long long a, long long b) { return a + b; });
+  });
+  auto resource = scheduler.createSemaphore();
+
+  // Задача low наследует приоритет заблокированной задачи high
+  assert(resource->acquire(low));
+  assert(!resource->acquire(high));
+  assert(!high->isReady());
+  assert(low->getPriority() == 15);
+
+  assert(scheduler.step());
+  for (std::size_t i = 0; i < count; ++i)
+    assert(squares[i] == static_cast<int>(i * i));
+  assert(sum == static_cast<long long>(count * (count - 1) / 2));
+  assert(helperChunks > 0);
+  assert(!wrongPriority);
+  assert(!notRunning);
+
+  // После цикла потоки простаивают; число потоков уже не меняется
+  for (int w = 0; w < 2; ++w)
+    assert(scheduler.getWorkers().getWorkerPriority(w) == -1);
+  assert(!scheduler.getWorkers().setWorkerCount(1));
+
+  // Пустой диапазон не вызывает тело
+  bool called = false;
+  scheduler.parallelFor(low, 5, 5, 1,
+                        [&](std::size_t, std::size_t) { called = true; });
+  assert(!called);
+  assert(scheduler.parallelReduce(
+             low, 0, 0, 1, 7, [](std::size_t, std::size_t) { return 1; },
+             [](int a, int b) { return a + b; }) == 7);
+
+  // Приоритет ОС: у политик реального времени отражает PIP, у прочих
+  // остаётся приоритетом потока задачи
+  int fifoMin = sched_get_priority_min(SCHED_FIFO);
+  assert(RTOS::mapOsPriority(SCHED_FIFO, fifoMin, 15) == fifoMin + 15);
+  assert(RTOS::mapOsPriority(SCHED_FIFO, fifoMin + 40, 15) == fifoMin + 40);
+  assert(RTOS::mapOsPriority(SCHED_FIFO, fifoMin, 1000) ==
+         sched_get_priority_max(SCHED_FIFO));
+  assert(RTOS::mapOsPriority(SCHED_OTHER, 0, 15) == 0);
+
+  // Если процессу разрешён SCHED_FIFO, вспомогательный поток получает
+  // приоритет ОС унаследованного приоритета задачи
+  int policy;
+  sched_param original;
+  pthread_getschedparam(pthread_self(), &policy, &original);
+  sched_param realtime = original;
+  realtime.sched_priority = fifoMin;
+  if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &realtime) == 0) {
+    std::atomic<int> helperOsPriority(-1);
+    scheduler.parallelFor(
+        low, 0, count, 1, [&](std::size_t, std::size_t) {
+          if (std::this_thread::get_id() != caller) {
+            int helperPolicy;
+            sched_param helperParam;
+            pthread_getschedparam(pthread_self(), &helperPolicy,
+                                  &helperParam);
+            if (helperPolicy == SCHED_FIFO) {
+              helperOsPriority = helperParam.sched_priority;
+            }
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+    pthread_setschedparam(pthread_self(), policy, &original);
+    assert(helperOsPriority == -1 || helperOsPriority == fifoMin + 15);
+  }
+
+  resource->release(low);
+  assert(low->getPriority() == 14);
+}
@@ -0,0 +1,132 @@
+// test_runtime_tasks.cpp
+#include "../include/rtos.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+void testRuntimeTasks() {
+  RTOS::Scheduler scheduler;
+  RTOS::SystemLog &logger = RTOS::SystemLog::getInstance();
+  logger.clearLog();
+
+  std::atomic<int> slowRuns(0);
+  std::atomic<int> fastRuns(0);
+
+  auto slowTask = scheduler.createTask(0, 100, [&]() {
+    slowRuns++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+
+  scheduler.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  assert(slowRuns > 0);
+
+  // Добавление задачи во время работы планировщика
+  auto fastTask = scheduler.createTask(0, 50, [&]() {
+    fastRuns++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+  assert(fastTask != nullptr);
+  assert(scheduler.getTasks().size() == 2);
+  assert(scheduler.getTasks()[0] == fastTask);
+  assert(fastTask->getPriority() > slowTask->getPriority());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  assert(fastRuns > 0);
+
+  // Контроль допустимости по известному времени выполнения: загрузка
+  // укладывается в границу Лью-Лейланда, но без вытеснения задание задачи
+  // heavyTask блокирует короткую задачу дольше её периода
+  auto heavyTask = scheduler.createTask(0, 1000, []() {}, 600);
+  assert(heavyTask != nullptr);
+  heavyTask->setReady(false);
+  assert(scheduler.createTask(0, 20, []() {}, 2) == nullptr);
+  assert(scheduler.createTask(0, 1000, []() {}, 500) == nullptr);
+  assert(scheduler.getTasks().size() == 3);
+
+  // Удаление задачи во время работы планировщика
+  int fastId = fastTask->getId();
+  assert(scheduler.destroyTask(fastTask));
+  assert(scheduler.getTasks().size() == 2);
+  assert(!scheduler.destroyTask(fastTask));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  int fastRunsAfterRemoval = fastRuns;
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  assert(fastRuns == fastRunsAfterRemoval);
+
+  // Задача, удерживающая семафор, не удаляется
+  auto semaphore = scheduler.createSemaphore();
+  assert(semaphore->acquire(heavyTask));
+  assert(!scheduler.destroyTask(heavyTask));
+  semaphore->release(heavyTask);
+  assert(scheduler.destroyTask(heavyTask));
+
+  scheduler.stop();
+
+  // Идентификатор освобождённой задачи используется повторно
+  auto reusedTask = scheduler.createTask(0, 200, []() {});
+  assert(reusedTask != nullptr);
+  assert(reusedTask->getId() == fastId);
+
+  // Задача, от имени которой поток ждёт на futex, не удаляется
+  auto waitingTask = scheduler.createTask(0, 300, []() {});
+  assert(semaphore->acquire(reusedTask));
+  std::atomic<bool> acquired(false);
+  std::thread waiter([&]() {
+    acquired =
+        semaphore->acquire(waitingTask, std::chrono::milliseconds(1000));
+  });
+  while (semaphore->getWaitingTasks().empty())
+    std::this_thread::yield();
+  assert(!scheduler.destroyTask(waitingTask));
+  semaphore->release(reusedTask);
+  waiter.join();
+  assert(acquired);
+  semaphore->release(waitingTask);
+  assert(scheduler.destroyTask(waitingTask));
+
+  // Удаление во время тела задачи, выполняемого другим потоком: тело уже
+  // не захватывает семафор, а память освобождается только после шага
+  RTOS::Scheduler stepped;
+  auto resource = stepped.createSemaphore();
+  std::atomic<int> phase(0);
+  std::atomic<bool> victimAcquired(true);
+  RTOS::Task *victim = nullptr;
+  victim = stepped.createTask(0, 100, [&]() {
+    phase = 1;
+    while (phase != 2)
+      std::this_thread::yield();
+    victimAcquired = resource->acquire(victim);
+  });
+  int victimId = victim->getId();
+  std::thread dispatcher([&]() { assert(stepped.step()); });
+  while (phase != 1)
+    std::this_thread::yield();
+  assert(stepped.destroyTask(victim));
+  assert(stepped.createTask(0, 200, []() {})->getId() != victimId);
+  phase = 2;
+  dispatcher.join();
+  assert(!victimAcquired);
+  assert(resource->getHolders().empty());
+  assert(resource->getWaitingTasks().empty());
+
+  // Удаление из собственного тела: ожидание после него тоже отклоняется
+  auto holder = stepped.createTask(0, 300, []() {});
+  assert(resource->acquire(holder));
+  holder->setReady(false);
+  RTOS::Task *self = nullptr;
+  bool selfDestroyed = false;
+  bool selfAcquired = true;
+  self = stepped.createTask(0, 50, [&]() {
+    selfDestroyed = stepped.destroyTask(self);
+    selfAcquired = resource->acquire(self);
+  });
+  assert(stepped.step());
+  assert(selfDestroyed);
+  assert(!selfAcquired);
+  assert(resource->getWaitingTasks().empty());
+  assert(stepped.getTasks().size() == 2);
+  resource->release(holder);
+}
@@ -57,6 +57,7 @@ void testSemaphores() {
 
   // Проверяем, что приоритет task1 был временно повышен (наследование
   // приоритета)
+#if RTOS_LOG_LEVEL >= RTOS_LOG_LEVEL_INFO
   auto logs = logger.getLog();
   bool priorityInheritanceFound = false;
   for (const auto &log : logs) {
@@ -66,4 +67,5 @@ void testSemaphores() {
     }
   }
   assert(priorityInheritanceFound);
+#endif
 }
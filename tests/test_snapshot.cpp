@@ -0,0 +1,82 @@
+// test_snapshot.cpp
+#include "../include/rtos.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+void testSnapshots() {
+  RTOS::Scheduler scheduler;
+  RTOS::SystemLog &logger = RTOS::SystemLog::getInstance();
+  logger.clearLog();
+
+  auto semaphore = scheduler.createSemaphore();
+
+  RTOS::Task *holder = nullptr;
+  RTOS::Task *waiter = nullptr;
+
+  // Задача захватывает семафор и больше не освобождает его
+  holder = scheduler.createTask(0, 200, [&]() {
+    assert(semaphore->acquire(holder));
+    holder->setReady(false);
+  });
+
+  // Задача блокируется на семафоре
+  waiter = scheduler.createTask(0, 100, [&]() {
+    semaphore->acquire(waiter);
+    waiter->setReady(false);
+  });
+  waiter->setReady(false);
+
+  auto idle = scheduler.createTask(0, 300, []() {});
+  idle->setReady(false);
+
+  // Монитор опрашивает срезы, пока планировщик работает
+  std::atomic<bool> monitoring(true);
+  std::atomic<int> reads(0);
+  std::thread monitor([&]() {
+    std::uint64_t lastVersion = 0;
+    while (monitoring) {
+      RTOS::SchedulerSnapshot state = scheduler.getSnapshot();
+      assert(state.version >= lastVersion);
+      lastVersion = state.version;
+      if (state.version > 0) {
+        assert(state.taskCount == 3);
+        assert(state.semaphoreCount == 1);
+      }
+      reads++;
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  });
+
+  scheduler.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  waiter->setReady(true);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  RTOS::SchedulerSnapshot state = scheduler.getSnapshot();
+  assert(state.running);
+  assert(state.runningTaskId == -1);
+
+  const RTOS::SemaphoreState &semState = state.semaphores[0];
+  assert(semState.count == 0);
+  assert(semState.holders == (1u << holder->getId()));
+  assert(semState.waiters == (1u << waiter->getId()));
+
+  for (int i = 0; i < state.taskCount; ++i) {
+    const RTOS::TaskState &taskState = state.tasks[i];
+    assert(!taskState.ready);
+    if (taskState.id == holder->getId()) {
+      // Держатель унаследовал приоритет ожидающей задачи
+      assert(taskState.priority == waiter->getPriority());
+      assert(taskState.basePriority < taskState.priority);
+    }
+  }
+
+  scheduler.stop();
+  monitoring = false;
+  monitor.join();
+
+  assert(reads > 0);
+  assert(!scheduler.getSnapshot().running);
+}
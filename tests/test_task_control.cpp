@@ -0,0 +1,39 @@
+// test_task_control.cpp
+#include "../include/rtos.h"
+#include <cassert>
+
+void testTaskControlBlocks() {
+  RTOS::TaskControlBlocks blocks;
+  assert(blocks.selectReady(~0u) == -1);
+  assert(blocks.highestPriority(0) == -1);
+
+  blocks.reset(0, 3, 200);
+  blocks.reset(1, 7, 100);
+  blocks.reset(2, 7, 50);
+  blocks.reset(31, 12, 400);
+
+  // Наивысший приоритет среди кандидатов
+  assert(blocks.selectReady(0x7u) == 2);
+  assert(blocks.selectReady(~0u) == 31);
+  assert(blocks.highestPriority(0x3u) == 7);
+
+  // Равные приоритеты разрешаются по меньшему периоду
+  blocks.setReady(2, false);
+  assert(blocks.selectReady(0x7u) == 1);
+  blocks.reset(2, 7, 100);
+  assert(blocks.selectReady(0x7u) == 1);
+
+  // Наследование меняет только эффективный приоритет
+  blocks.setPriority(0, 9);
+  assert(blocks.getPriority(0) == 9);
+  assert(blocks.getBasePriority(0) == 3);
+  assert(blocks.selectReady(0x7u) == 0);
+
+  // Соседние байты одного слова не затираются
+  assert(blocks.getPriority(1) == 7);
+  assert(blocks.getPriority(2) == 7);
+
+  blocks.setReady(31, false);
+  assert(!blocks.isReady(31));
+  assert(blocks.selectReady(1u << 31) == -1);
+}
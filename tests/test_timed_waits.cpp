@@ -0,0 +1,184 @@
+// test_timed_waits.cpp
+#include "../include/rtos.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+// Ожидания с таймаутом из тел задач: поток планировщика не блокируется
+static void testKernelTimedWaits() {
+  // Держатель освобождает ресурс, пока ожидающая задача не готова
+  {
+    RTOS::Scheduler scheduler;
+    auto semaphore = scheduler.createSemaphore();
+    std::atomic<int> acquired(0);
+    std::atomic<int> timedOut(0);
+    RTOS::Task *waiter = nullptr;
+    RTOS::Task *holder = nullptr;
+
+    waiter = scheduler.createTask(0, 100, [&]() {
+      if (acquired || timedOut) {
+        return;
+      }
+      if (semaphore->acquire(waiter, std::chrono::milliseconds(50))) {
+        acquired++;
+        semaphore->release(waiter);
+      } else if (waiter->isReady()) {
+        timedOut++;
+      }
+    });
+    holder = scheduler.createTask(0, 200, [&]() {
+      if (semaphore->getHeldUnits(holder) > 0) {
+        semaphore->release(holder);
+      }
+    });
+    assert(semaphore->acquire(holder));
+
+    scheduler.start();
+    for (int i = 0; i < 100 && !acquired && !timedOut; ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    scheduler.stop();
+    assert(acquired == 1);
+    assert(timedOut == 0);
+  }
+
+  // Срок истекает на точке диспетчеризации
+  RTOS::Scheduler scheduler;
+  auto semaphore = scheduler.createSemaphore();
+  RTOS::Task *waiter = nullptr;
+  int outcome = 0; // 1 - захват, 2 - таймаут
+  waiter = scheduler.createTask(0, 100, [&]() {
+    if (semaphore->acquire(waiter, std::chrono::milliseconds(20))) {
+      outcome = 1;
+    } else if (waiter->isReady()) {
+      outcome = 2;
+    }
+  });
+  auto holder = scheduler.createTask(0, 200, []() {});
+  assert(semaphore->acquire(holder));
+  holder->setReady(false);
+
+  auto begin = std::chrono::steady_clock::now();
+  assert(scheduler.step());
+  assert(std::chrono::steady_clock::now() - begin <
+         std::chrono::milliseconds(20));
+  assert(!waiter->isReady());
+  assert(holder->getPriority() == waiter->getPriority());
+  assert(!scheduler.step());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(25));
+  assert(scheduler.step());
+  assert(outcome == 2);
+  assert(semaphore->getWaitingTasks().empty());
+  assert(holder->getPriority() == holder->getBasePriority());
+
+  // Событие будит ожидающую задачу до срока
+  auto event = scheduler.createEvent(holder);
+  RTOS::Task *listener = nullptr;
+  outcome = 0;
+  listener = scheduler.createTask(0, 50, [&]() {
+    if (event->waitFor(listener, std::chrono::milliseconds(1000))) {
+      outcome = 1;
+    } else if (listener->isReady()) {
+      outcome = 2;
+    }
+  });
+  waiter->setReady(false);
+
+  assert(scheduler.step());
+  assert(outcome == 0);
+  assert(!listener->isReady());
+  event->trigger();
+  assert(scheduler.step());
+  assert(outcome == 1);
+
+  // Активация сообщается повторным вызовом, даже если событие уже сброшено
+  event->reset();
+  outcome = 0;
+  assert(scheduler.step());
+  assert(!listener->isReady());
+  event->trigger();
+  event->reset();
+  assert(scheduler.step());
+  assert(outcome == 1);
+  listener->setReady(false);
+
+  // Единицы, освобождённые для ожидающей задачи, забирает другая задача:
+  // повторный захват продолжает исходное ожидание и не продлевает срок
+  auto contended = scheduler.createSemaphore();
+  auto greedy = scheduler.createTask(0, 400, []() {});
+  greedy->setReady(false);
+  assert(contended->acquire(holder));
+  outcome = 0;
+  waiter = scheduler.createTask(0, 10, [&]() {
+    if (contended->acquire(waiter, std::chrono::milliseconds(20))) {
+      outcome = 1;
+    } else if (waiter->isReady()) {
+      outcome = 2;
+    }
+  });
+  assert(scheduler.step());
+  assert(!waiter->isReady());
+  contended->release(holder);
+  assert(waiter->isReady());
+  assert(contended->tryAcquire(greedy));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(25));
+  assert(scheduler.step());
+  assert(outcome == 2);
+  assert(contended->getWaitingTasks().empty());
+  contended->release(greedy);
+}
+
+void testTimedWaits() {
+  testKernelTimedWaits();
+
+  RTOS::Scheduler scheduler;
+  RTOS::SystemLog &logger = RTOS::SystemLog::getInstance();
+  logger.clearLog();
+
+  auto semaphore = scheduler.createSemaphore();
+  auto holder = scheduler.createTask(1, 200, []() {});
+  auto waiter = scheduler.createTask(8, 100, []() {});
+  auto owner = scheduler.createTask(0, 300, []() {});
+  auto event = scheduler.createEvent(owner);
+
+  assert(semaphore->acquire(holder));
+  assert(!semaphore->tryAcquire(waiter));
+
+  // Ожидание истекает: задача снимается с очереди, PIP откатывается
+  auto begin = std::chrono::steady_clock::now();
+  assert(!semaphore->acquire(waiter, std::chrono::milliseconds(20)));
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  assert(elapsed >= std::chrono::milliseconds(20));
+  assert(semaphore->getWaitingTasks().empty());
+  assert(waiter->isReady());
+  assert(holder->getPriority() == 1);
+
+  // Освобождение из другого потока будит ожидающего раньше таймаута
+  std::thread releaser([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    assert(holder->getPriority() == 8);
+    semaphore->release(holder);
+  });
+  assert(semaphore->acquire(waiter, std::chrono::milliseconds(1000)));
+  releaser.join();
+  assert(semaphore->getHeldUnits(waiter) == 1);
+  assert(holder->getPriority() == 1);
+  semaphore->release(waiter);
+
+  // Ожидание события с таймаутом
+  assert(!event->waitFor(waiter, std::chrono::milliseconds(20)));
+  assert(waiter->isReady());
+
+  std::thread trigger([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    event->trigger();
+  });
+  assert(event->waitFor(waiter, std::chrono::milliseconds(1000)));
+  trigger.join();
+  assert(waiter->isReady());
+
+  // Уже активированное событие не блокирует
+  assert(event->waitFor(waiter, std::chrono::milliseconds(0)));
+}
@@ -0,0 +1,475 @@
+// stress_harness.cpp
+// Генератор синтетических наборов задач и нагрузочный стенд планировщика.
+// Каждый набор моделируется в виртуальном времени на настоящих объектах
+// ядра: планировщик продвигается по одной точке диспетчеризации
+// (Scheduler::step), а тела задач сдвигают виртуальные часы на длину
+// своих сегментов. Наборы обрабатываются параллельно на всех ядрах.
+//
+// Накладные расходы диспетчеризации измеряются по настенным часам, поэтому
+// при числе потоков больше числа ядер в них попадает вытеснение потоков.
+// Журнал ядра по умолчанию отключён: общий мьютекс журнала иначе
+// измерялся бы вместо ядра.
+#include "../include/rtos.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+using RTOS::Scheduler;
+using RTOS::Semaphore;
+using RTOS::Task;
+
+// Схема разделения ресурсов: без ресурсов, один общий семафор, группы
+// задач на своих семафорах либо вложенный захват двух семафоров
+enum class Pattern { None, Shared, Groups, Nested };
+
+struct Options {
+  int sets = 1000; // На каждую точку загрузки
+  int tasks = 8;
+  double utilizationMin = 0.5;
+  double utilizationMax = 0.95;
+  double utilizationStep = 0.05;
+  int periodMinMs = 10;
+  int periodMaxMs = 100;
+  Pattern pattern = Pattern::Shared;
+  int resources = 2;
+  double criticalSectionRatio = 0.25;
+  int horizonPeriods = 10; // Горизонт в наибольших периодах
+  int threads = 0;
+  unsigned long long seed = 1;
+  std::uint32_t logMask = 0; // Категории журнала ядра
+};
+
+// Участок задания, выполняемый за одну диспетчеризацию. Границы сегментов
+// - единственные точки, где планировщик без вытеснения может выбрать
+// другую задачу, в том числе пока ресурс удерживается.
+struct Segment {
+  long long length;
+  std::vector<int> acquire;
+  std::vector<int> release;
+};
+
+struct TaskSpec {
+  long long period; // Виртуальные микросекунды
+  long long wcet;
+  std::vector<Segment> segments;
+};
+
+struct SetResult {
+  long long jobs = 0;
+  long long misses = 0;
+  long long blockedJobs = 0;
+  long long blockingUs = 0;
+  long long maxBlockingUs = 0;
+  long long inversions = 0;
+  RTOS::DispatchStats dispatch = {};
+};
+
+// Алгоритм UUniFast (Bini, Buttazzo): равномерное распределение n
+// загрузок с суммой utilization
+std::vector<double> uunifast(int n, double utilization, std::mt19937_64 &rng) {
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::vector<double> result;
+  double sum = utilization;
+  for (int i = 1; i < n; ++i) {
+    double next = sum * std::pow(uniform(rng), 1.0 / (n - i));
+    result.push_back(sum - next);
+    sum = next;
+  }
+  result.push_back(sum);
+  return result;
+}
+
+std::vector<TaskSpec> generateSet(const Options &options, double utilization,
+                                  std::mt19937_64 &rng) {
+  std::uniform_real_distribution<double> logPeriod(
+      std::log(options.periodMinMs * 1000.0),
+      std::log(options.periodMaxMs * 1000.0));
+  std::uniform_int_distribution<int> pickResource(0, options.resources - 1);
+
+  std::vector<TaskSpec> set;
+  int index = 0;
+  for (double share : uunifast(options.tasks, utilization, rng)) {
+    TaskSpec spec;
+    spec.period = std::llround(std::exp(logPeriod(rng)));
+    spec.wcet = std::max(1ll, std::llround(share * spec.period));
+
+    std::vector<int> resources;
+    switch (options.pattern) {
+    case Pattern::None:
+      break;
+    case Pattern::Shared:
+      resources = {0};
+      break;
+    case Pattern::Groups:
+      resources = {index % options.resources};
+      break;
+    case Pattern::Nested: {
+      // Единый порядок захвата исключает взаимоблокировки
+      int outer = pickResource(rng);
+      int inner = pickResource(rng);
+      while (inner == outer)
+        inner = pickResource(rng);
+      resources = {std::min(outer, inner), std::max(outer, inner)};
+      break;
+    }
+    }
+
+    if (resources.empty()) {
+      spec.segments.push_back({spec.wcet, {}, {}});
+    } else {
+      // До, две половины критической секции и после
+      long long section = std::max(
+          1ll, std::llround(spec.wcet * options.criticalSectionRatio));
+      section = std::min(section, spec.wcet);
+      long long before = (spec.wcet - section) / 2;
+      long long after = spec.wcet - section - before;
+      std::vector<int> outer(resources.begin(), resources.begin() + 1);
+      std::vector<int> inner(resources.begin() + 1, resources.end());
+      std::vector<int> releaseOrder(resources.rbegin(), resources.rend());
+
+      spec.segments.push_back({before, {}, {}});
+      spec.segments.push_back({section / 2, outer, {}});
+      spec.segments.push_back({section - section / 2, inner, releaseOrder});
+      spec.segments.push_back({after, {}, {}});
+    }
+
+    set.push_back(spec);
+    index++;
+  }
+  return set;
+}
+
+// Моделирование одного набора в виртуальном времени
+class Simulation {
+private:
+  struct TaskRun {
+    const TaskSpec *spec;
+    Task *task;
+    std::deque<long long> releases; // Невыполненные задания
+    long long nextRelease;
+    size_t segment;
+    size_t acquired;
+    bool blocked;
+    long long blockedSince;
+    long long jobBlocking;
+  };
+
+  Scheduler scheduler;
+  std::vector<Semaphore *> semaphores;
+  std::vector<TaskRun> runs;
+  long long now;
+  SetResult result;
+
+  void runSegment(TaskRun &run);
+  void completeJob(TaskRun &run);
+
+public:
+  SetResult run(const std::vector<TaskSpec> &set, int resources,
+                long long horizon);
+};
+
+void Simulation::runSegment(TaskRun &run) {
+  const Segment &segment = run.spec->segments[run.segment];
+
+  // Захват ресурсов сегмента по порядку; при неудаче ядро ставит задачу в
+  // очередь семафора и снимает с готовности до его освобождения
+  while (run.acquired < segment.acquire.size()) {
+    Semaphore *semaphore = semaphores[segment.acquire[run.acquired]];
+    if (!semaphore->acquire(run.task)) {
+      if (!run.blocked) {
+        run.blocked = true;
+        run.blockedSince = now;
+      }
+      return;
+    }
+    run.acquired++;
+  }
+
+  if (run.blocked) {
+    run.jobBlocking += now - run.blockedSince;
+    run.blocked = false;
+  }
+
+  now += segment.length;
+  for (int resource : segment.release)
+    semaphores[resource]->release(run.task);
+
+  run.acquired = 0;
+  if (++run.segment == run.spec->segments.size()) {
+    completeJob(run);
+  }
+}
+
+void Simulation::completeJob(TaskRun &run) {
+  long long release = run.releases.front();
+  run.releases.pop_front();
+
+  result.jobs++;
+  if (now > release + run.spec->period) {
+    result.misses++;
+  }
+  if (run.jobBlocking > 0) {
+    result.blockedJobs++;
+    result.blockingUs += run.jobBlocking;
+    result.maxBlockingUs = std::max(result.maxBlockingUs, run.jobBlocking);
+  }
+
+  run.segment = 0;
+  run.jobBlocking = 0;
+  if (run.releases.empty()) {
+    run.task->setReady(false);
+  }
+}
+
+SetResult Simulation::run(const std::vector<TaskSpec> &set, int resources,
+                          long long horizon) {
+  now = 0;
+  for (int i = 0; i < resources; ++i)
+    semaphores.push_back(scheduler.createSemaphore());
+
+  // Указатели на элементы runs стабильны: вектор заполняется заранее
+  runs.reserve(set.size());
+  for (auto &spec : set) {
+    runs.push_back({&spec, nullptr, {}, 0, 0, 0, false, 0, 0});
+    TaskRun &run = runs.back();
+    run.task = scheduler.createTask(0, static_cast<int>(spec.period),
+                                    [this, &run]() { runSegment(run); });
+    run.task->setReady(false);
+  }
+
+  while (now < horizon) {
+    long long next = horizon;
+    for (auto &run : runs) {
+      while (run.nextRelease <= now) {
+        run.releases.push_back(run.nextRelease);
+        run.nextRelease += run.spec->period;
+        // Задача, ожидающая семафор, станет готовой при его освобождении
+        if (!run.blocked) {
+          run.task->setReady(true);
+        }
+      }
+      next = std::min(next, run.nextRelease);
+    }
+
+    if (!scheduler.step()) {
+      now = next;
+    }
+  }
+
+  // Незавершённые задания с истёкшим сроком - тоже промахи
+  for (auto &run : runs) {
+    for (long long release : run.releases) {
+      if (release + run.spec->period <= horizon) {
+        result.jobs++;
+        result.misses++;
+      }
+    }
+  }
+
+  for (auto semaphore : semaphores)
+    result.inversions += semaphore->getInversionCount();
+  result.dispatch = scheduler.getDispatchStats();
+  return result;
+}
+
+bool parsePattern(const char *name, Pattern &pattern) {
+  if (std::strcmp(name, "none") == 0) {
+    pattern = Pattern::None;
+  } else if (std::strcmp(name, "shared") == 0) {
+    pattern = Pattern::Shared;
+  } else if (std::strcmp(name, "groups") == 0) {
+    pattern = Pattern::Groups;
+  } else if (std::strcmp(name, "nested") == 0) {
+    pattern = Pattern::Nested;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void printUsage(const char *program) {
+  std::cerr
+      << "Usage: " << program << " [options]\n"
+      << "  --sets N            task sets per utilization point (1000)\n"
+      << "  --tasks N           tasks per set (8)\n"
+      << "  --util-min U        lowest total utilization (0.5)\n"
+      << "  --util-max U        highest total utilization (0.95)\n"
+      << "  --util-step U       utilization step (0.05)\n"
+      << "  --period-min MS     shortest period (10)\n"
+      << "  --period-max MS     longest period (100)\n"
+      << "  --pattern P         none | shared | groups | nested (shared)\n"
+      << "  --resources N       semaphores for groups/nested (2)\n"
+      << "  --cs-ratio R        critical section share of WCET (0.25)\n"
+      << "  --horizon N         simulated longest periods per set (10)\n"
+      << "  --threads N         worker threads (all cores)\n"
+      << "  --seed N            random seed (1)\n"
+      << "  --log-mask M        kernel log categories, e.g. 0x1 (0: off)\n";
+}
+
+bool parseOptions(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; ++i) {
+    const char *name = argv[i];
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const char *value = argv[++i];
+
+    if (std::strcmp(name, "--sets") == 0) {
+      options.sets = std::atoi(value);
+    } else if (std::strcmp(name, "--tasks") == 0) {
+      options.tasks = std::atoi(value);
+    } else if (std::strcmp(name, "--util-min") == 0) {
+      options.utilizationMin = std::atof(value);
+    } else if (std::strcmp(name, "--util-max") == 0) {
+      options.utilizationMax = std::atof(value);
+    } else if (std::strcmp(name, "--util-step") == 0) {
+      options.utilizationStep = std::atof(value);
+    } else if (std::strcmp(name, "--period-min") == 0) {
+      options.periodMinMs = std::atoi(value);
+    } else if (std::strcmp(name, "--period-max") == 0) {
+      options.periodMaxMs = std::atoi(value);
+    } else if (std::strcmp(name, "--pattern") == 0) {
+      if (!parsePattern(value, options.pattern)) {
+        return false;
+      }
+    } else if (std::strcmp(name, "--resources") == 0) {
+      options.resources = std::atoi(value);
+    } else if (std::strcmp(name, "--cs-ratio") == 0) {
+      options.criticalSectionRatio = std::atof(value);
+    } else if (std::strcmp(name, "--horizon") == 0) {
+      options.horizonPeriods = std::atoi(value);
+    } else if (std::strcmp(name, "--threads") == 0) {
+      options.threads = std::atoi(value);
+    } else if (std::strcmp(name, "--seed") == 0) {
+      options.seed = std::strtoull(value, nullptr, 10);
+    } else if (std::strcmp(name, "--log-mask") == 0) {
+      options.logMask =
+          static_cast<std::uint32_t>(std::strtoul(value, nullptr, 0));
+    } else {
+      return false;
+    }
+  }
+
+  int minResources = options.pattern == Pattern::Nested ? 2 : 1;
+  return options.sets > 0 && options.tasks > 0 &&
+         options.tasks <= RTOS::MAX_TASKS && options.utilizationMin > 0 &&
+         options.utilizationMax >= options.utilizationMin &&
+         options.utilizationStep > 0 && options.periodMinMs > 0 &&
+         options.periodMaxMs >= options.periodMinMs &&
+         options.resources >= minResources &&
+         options.resources <= RTOS::MAX_RESOURCES &&
+         options.criticalSectionRatio > 0 &&
+         options.criticalSectionRatio <= 1 && options.horizonPeriods > 0 &&
+         options.threads >= 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  std::vector<double> points;
+  for (double u = options.utilizationMin;
+       u <= options.utilizationMax + 1e-9; u += options.utilizationStep) {
+    points.push_back(u);
+  }
+
+  int resources = options.pattern == Pattern::None     ? 0
+                  : options.pattern == Pattern::Shared ? 1
+                                                       : options.resources;
+  long long horizon = options.horizonPeriods * options.periodMaxMs * 1000ll;
+
+  RTOS::SystemLog::setCategoryMask(options.logMask);
+
+  int cores =
+      static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  int threadCount = options.threads > 0 ? options.threads : cores;
+  if (threadCount > cores) {
+    std::cerr << "Warning: " << threadCount << " threads on " << cores
+              << " cores; dispatch times include thread preemption\n";
+  }
+  size_t total = points.size() * options.sets;
+  std::vector<SetResult> results(total);
+  std::atomic<size_t> nextSet(0);
+
+  auto started = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threadCount; ++i) {
+    workers.emplace_back([&]() {
+      for (size_t index = nextSet++; index < total; index = nextSet++) {
+        // Набор определяется только зерном и номером, а не потоком
+        std::mt19937_64 rng(options.seed * 1000003ull + index);
+        double utilization = points[index / options.sets];
+        auto set = generateSet(options, utilization, rng);
+
+        Simulation simulation;
+        results[index] = simulation.run(set, resources, horizon);
+
+        // Включённый журнал иначе растёт без ограничений
+        if (options.logMask) {
+          RTOS::SystemLog::getInstance().clearLog();
+        }
+      }
+    });
+  }
+  for (auto &worker : workers)
+    worker.join();
+  double elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - started)
+                       .count();
+
+  std::cout << "Sets: " << total << " (" << options.tasks << " tasks, "
+            << threadCount << " threads, " << std::fixed
+            << std::setprecision(1) << elapsed << " s)\n";
+  std::cout << "   U   miss%  sets-miss%    dispatch-ns avg/max"
+               "   blocking-us avg/max  inversions/set\n";
+
+  for (size_t point = 0; point < points.size(); ++point) {
+    SetResult sum;
+    int setsWithMisses = 0;
+    for (int i = 0; i < options.sets; ++i) {
+      const SetResult &r = results[point * options.sets + i];
+      sum.jobs += r.jobs;
+      sum.misses += r.misses;
+      sum.blockedJobs += r.blockedJobs;
+      sum.blockingUs += r.blockingUs;
+      sum.maxBlockingUs = std::max(sum.maxBlockingUs, r.maxBlockingUs);
+      sum.inversions += r.inversions;
+      sum.dispatch.dispatches += r.dispatch.dispatches;
+      sum.dispatch.totalOverheadNs += r.dispatch.totalOverheadNs;
+      sum.dispatch.maxOverheadNs =
+          std::max(sum.dispatch.maxOverheadNs, r.dispatch.maxOverheadNs);
+      setsWithMisses += r.misses > 0;
+    }
+
+    double missRatio = sum.jobs ? 100.0 * sum.misses / sum.jobs : 0.0;
+    double overhead = sum.dispatch.dispatches
+                          ? static_cast<double>(sum.dispatch.totalOverheadNs) /
+                                sum.dispatch.dispatches
+                          : 0.0;
+    double blocking =
+        sum.blockedJobs ? static_cast<double>(sum.blockingUs) / sum.blockedJobs
+                        : 0.0;
+
+    std::cout << std::setprecision(2) << std::setw(5) << points[point]
+              << std::setprecision(2) << std::setw(8) << missRatio
+              << std::setw(12) << 100.0 * setsWithMisses / options.sets
+              << std::setprecision(0) << std::setw(14) << overhead << " / "
+              << std::setw(8) << sum.dispatch.maxOverheadNs << std::setw(10)
+              << blocking << " / " << std::setw(7) << sum.maxBlockingUs
+              << std::setprecision(2) << std::setw(16)
+              << static_cast<double>(sum.inversions) / options.sets << "\n";
+  }
+  return 0;
+}